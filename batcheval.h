@@ -0,0 +1,104 @@
+#ifndef BATCHEVAL_H
+#define BATCHEVAL_H
+
+/**
+ * Evaluation of one polynomial at several points at once, one point per
+ * SIMD lane, with arithmetic modulo a prime below batchModulusLimit.
+ *
+ * Residues are carried in doubles: with a modulus under 2^26 the product
+ * of two residues is below 2^52 and so is represented exactly, and the
+ * reduction t - floor(t / m) m can be done with vector multiplies and
+ * conversions, which (unlike 64-bit integer division) every SIMD unit
+ * supports.
+ */
+
+const unsigned long long batchModulusLimit = 1ULL << 26;
+
+template <int Lanes> struct LaneVectors;
+
+template <> struct LaneVectors<4> {
+    typedef double Real __attribute__((vector_size(4 * sizeof(double))));
+    typedef long long Integer __attribute__((vector_size(4 * sizeof(long long))));
+};
+
+template <> struct LaneVectors<8> {
+    typedef double Real __attribute__((vector_size(8 * sizeof(double))));
+    typedef long long Integer __attribute__((vector_size(8 * sizeof(long long))));
+};
+
+template <> struct LaneVectors<16> {
+    typedef double Real __attribute__((vector_size(16 * sizeof(double))));
+    typedef long long Integer __attribute__((vector_size(16 * sizeof(long long))));
+};
+
+/**
+ * Evaluate a dense polynomial at Lanes points modulo m, walking its
+ * coefficients once by Horner's rule in every lane simultaneously.
+ *
+ * @param coeffs the coefficients, lowest power first, as residues in [0, m)
+ * @param degree the degree of the polynomial
+ * @param xs Lanes points, as residues in [0, m)
+ * @param m the modulus, below batchModulusLimit
+ * @param values output: Lanes values, as residues in [0, m)
+ */
+template <int Lanes>
+void evaluateLanes(const double* coeffs, int degree, const double* xs, double m, double* values)
+{
+    typedef typename LaneVectors<Lanes>::Real Real;
+    typedef typename LaneVectors<Lanes>::Integer Integer;
+
+    Real x;
+    for (int lane = 0; lane < Lanes; ++lane)
+        x[lane] = xs[lane];
+    Real h = {};
+    const double inverse = 1.0 / m;
+    for (int i = degree; i >= 0; --i)
+    {
+        Real t = h * x + coeffs[i];
+        // The truncated quotient may be off by one either way; the two
+        // corrections below bring h back into [0, m).
+        Real q = __builtin_convertvector(__builtin_convertvector(t * inverse, Integer), Real);
+        h = t - q * m;
+        h = (h < 0) ? h + m : h;
+        h = (h >= m) ? h - m : h;
+    }
+    for (int lane = 0; lane < Lanes; ++lane)
+        values[lane] = h[lane];
+}
+
+/**
+ * Evaluate a dense polynomial at any number of points modulo m, passing
+ * them through evaluateLanes 16, 8 or 4 at a time.
+ *
+ * @param coeffs the coefficients, lowest power first, as residues in [0, m)
+ * @param degree the degree of the polynomial
+ * @param xs count points, as residues in [0, m)
+ * @param count the number of points
+ * @param m the modulus, below batchModulusLimit
+ * @param values output: count values, as residues in [0, m)
+ */
+inline void evaluateBatch(const double* coeffs, int degree, const double* xs, size_t count,
+                          double m, double* values)
+{
+    // Lanes beyond the end of xs in the final batch evaluate at 0.
+    double points[16], results[16];
+    size_t start = 0;
+    while (start < count)
+    {
+        size_t remaining = count - start;
+        int lanes = (remaining >= 16) ? 16 : (remaining >= 8) ? 8 : 4;
+        for (int lane = 0; lane < lanes; ++lane)
+            points[lane] = (start + lane < count) ? xs[start + lane] : 0.0;
+        if (lanes == 16)
+            evaluateLanes<16>(coeffs, degree, points, m, results);
+        else if (lanes == 8)
+            evaluateLanes<8>(coeffs, degree, points, m, results);
+        else
+            evaluateLanes<4>(coeffs, degree, points, m, results);
+        for (int lane = 0; lane < lanes && start + lane < count; ++lane)
+            values[start + lane] = results[lane];
+        start += lanes;
+    }
+}
+
+#endif
@@ -0,0 +1,298 @@
+#include "cyclotomic.h"
+#include "divisors.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <numeric>
+
+using namespace std;
+
+
+// Dense integer polynomials, lowest power first.
+typedef vector<long long> Dense;
+
+static bool byPower(const Term& left, const Term& right) {
+    return left.power < right.power;
+}
+
+/**
+ * @return false if base^exponent overflows a long long
+ */
+static bool power(long long base, int exponent, long long& result) {
+    result = 1;
+    for (int i = 0; i < exponent; ++i) {
+        if (__builtin_mul_overflow(result, base, &result)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @param a a positive integer
+ * @return false if a is not the n-th power of an integer, otherwise
+ *         true with root set to its positive n-th root
+ */
+static bool exactRoot(long long a, int n, long long& root) {
+    if (a == 1) {
+        root = 1;
+        return true;
+    }
+    if (n >= 63) {
+        return false;
+    }
+    long long estimate = llroundl(powl((long double) a, 1.0L / n));
+    for (long long r = max(estimate - 1, 1LL); r <= estimate + 1; ++r) {
+        long long value;
+        if (power(r, n, value) && value == a) {
+            root = r;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * The coefficients of Phi_r, r being the product of the distinct primes
+ * of n, with spread set to n / r.
+ *
+ * For r > 1 the product of the distinct primes of n, Phi_r is the
+ * product over d | r of (1 - x^d)^mu(r / d), which is worked out as a
+ * power series cut off at its degree phi(r): multiplying by 1 - x^d and
+ * dividing by it each take one pass over the coefficients. The divisors
+ * are taken in pairs d and d / p, p being the smallest prime of r, whose
+ * quotient 1 + x^(d/p) + ... + x^(d - d/p) keeps the coefficients from
+ * growing in between.
+ *
+ * @return false if a coefficient overflows a long long
+ */
+static bool radicalCoefficients(int n, Dense& c, int& spread) {
+    spread = 1;
+    if (n == 1) {
+        c = {-1, 1};
+        return true;
+    }
+    vector<int> primes;
+    int r = 1, degree = 1;
+    for (const pair<unsigned long long, int>& f : factorInteger(n)) {
+        primes.push_back((int) f.first);
+        r *= (int) f.first;
+        degree *= (int) f.first - 1;
+    }
+    c.assign(degree + 1, 0);
+    c[0] = 1;
+    auto multiply = [&](int d) {
+        for (int i = degree; i >= d; --i) {
+            if (__builtin_sub_overflow(c[i], c[i - d], &c[i])) {
+                return false;
+            }
+        }
+        return true;
+    };
+    auto divide = [&](int d) {
+        for (int i = d; i <= degree; ++i) {
+            if (__builtin_add_overflow(c[i], c[i - d], &c[i])) {
+                return false;
+            }
+        }
+        return true;
+    };
+    int others = primes.size() - 1;
+    for (int subset = 0; subset < (1 << others); ++subset) {
+        int d = r;
+        int size = 0;
+        for (int i = 0; i < others; ++i) {
+            if (subset & (1 << i)) {
+                d /= primes[i + 1];
+                ++size;
+            }
+        }
+        bool ok = (size % 2 == 0) ? multiply(d) && divide(d / primes[0])
+                                  : multiply(d / primes[0]) && divide(d);
+        if (!ok) {
+            return false;
+        }
+    }
+    spread = n / r;
+    return true;
+}
+
+Polynomial cyclotomic(int n) {
+    Dense c;
+    int spread;
+    if (!radicalCoefficients(n, c, spread)) {
+        return Polynomial();
+    }
+    vector<Term> terms;
+    for (size_t i = 0; i < c.size(); ++i) {
+        if (c[i] < INT_MIN || c[i] > INT_MAX) {
+            return Polynomial();
+        }
+        if (c[i] != 0) {
+            terms.emplace_back((int) c[i], (int) i * spread);
+        }
+    }
+    return Polynomial(terms);
+}
+
+/**
+ * v^phi(d) Phi_d(u x / v), or Polynomial() if a coefficient does not fit
+ * in an int.
+ */
+static Polynomial homogenized(int d, long long u, long long v) {
+    Polynomial phi = cyclotomic(d);
+    if (phi.getDegree() < 0 || (u == 1 && v == 1)) {
+        return phi;
+    }
+    int degree = phi.getDegree();
+    vector<int> coeffs(degree + 1, 0);
+    for (const Term& term : phi) {
+        long long uPower, vPower, c;
+        if (!power(u, term.power, uPower) || !power(v, degree - term.power, vPower)
+            || __builtin_mul_overflow(uPower, vPower, &c)
+            || __builtin_mul_overflow(c, (long long) term.coefficient, &c)
+            || c < INT_MIN || c > INT_MAX) {
+            return Polynomial();
+        }
+        coeffs[term.power] = (int) c;
+    }
+    return Polynomial(coeffs.size(), coeffs.data());
+}
+
+/**
+ * a x^n + c with a > 0 is (u x)^n - v^n for c < 0, and
+ * ((u x)^2n - v^2n) / ((u x)^n - v^n) for c > 0, where u and v are the
+ * n-th roots of a and |c|.
+ */
+static bool binomialFactors(long long a, long long c, int n, vector<Polynomial>& factors) {
+    long long u, v;
+    if (!exactRoot(a, n, u) || !exactRoot(abs(c), n, v)) {
+        return false;
+    }
+    long long order = (c < 0) ? n : 2LL * n;
+    if (order > INT_MAX) {
+        return false;
+    }
+    for (unsigned long long d : divisorsOf(order)) {
+        if (c > 0 && n % d == 0) {
+            continue;
+        }
+        Polynomial f = homogenized((int) d, u, v);
+        if (f.getDegree() < 0) {
+            return false;
+        }
+        factors.push_back(f);
+    }
+    return true;
+}
+
+/**
+ * @return true if c spread out to every spread-th power is d
+ */
+static bool spreadEquals(const Dense& c, int spread, const Dense& d) {
+    if ((c.size() - 1) * spread != d.size() - 1) {
+        return false;
+    }
+    for (size_t i = 0; i < d.size(); ++i) {
+        if (d[i] != ((i % spread == 0) ? c[i / spread] : 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * If q is Phi_m, the primitive d-th roots of unity with their k-th powers
+ * of order m, which are those with d | mk and d / gcd(d, k) = m, are the
+ * roots of q(x^k). Since m / phi(m) < 6 for m below 9699690, which
+ * covers every q up to maxCyclotomicDegree, m is looked for among the
+ * numbers up to 6 deg q.
+ *
+ * @param q the coefficients of a monic polynomial with constant term 1
+ */
+static bool deflatedFactors(const Dense& q, int k, vector<Polynomial>& factors) {
+    int degree = q.size() - 1;
+    if (degree > maxCyclotomicDegree) {
+        return false;
+    }
+    for (int i = 0; i <= degree; ++i) {
+        if (q[i] != q[degree - i]) {
+            return false;
+        }
+    }
+    int limit = 6 * degree;
+    vector<int> totient(limit + 1);
+    iota(totient.begin(), totient.end(), 0);
+    for (int i = 2; i <= limit; ++i) {
+        if (totient[i] == i) {
+            for (int j = i; j <= limit; j += i) {
+                totient[j] -= totient[j] / i;
+            }
+        }
+    }
+    for (int m = degree + 1; m <= limit; ++m) {
+        Dense phi;
+        int spread;
+        if (totient[m] != degree || !radicalCoefficients(m, phi, spread)
+            || !spreadEquals(phi, spread, q)) {
+            continue;
+        }
+        if ((long long) m * k > INT_MAX) {
+            return false;
+        }
+        vector<Polynomial> result;
+        for (unsigned long long d : divisorsOf((unsigned long long) m * k)) {
+            if ((long long) d / gcd((long long) d, (long long) k) != m) {
+                continue;
+            }
+            result.push_back(cyclotomic((int) d));
+            if (result.back().getDegree() < 0) {
+                return false;
+            }
+        }
+        factors.insert(factors.end(), result.begin(), result.end());
+        return true;
+    }
+    return false;
+}
+
+bool factorCyclotomic(const Polynomial& p, vector<Polynomial>& factors) {
+    vector<Term> nonzero;
+    for (const Term& term : p) {
+        if (term.coefficient != 0) {
+            nonzero.push_back(term);
+        }
+    }
+    if (nonzero.size() < 2) {
+        return false;
+    }
+    sort(nonzero.begin(), nonzero.end(), byPower);
+    int shift = nonzero.front().power;
+    int sign = (nonzero.back().coefficient < 0) ? -1 : 1;
+    vector<Polynomial> result(shift, Polynomial(0, 1));
+    long long a = sign * (long long) nonzero.back().coefficient;
+    long long c = sign * (long long) nonzero.front().coefficient;
+    if (nonzero.size() == 2) {
+        if (!binomialFactors(a, c, nonzero.back().power - shift, result)) {
+            return false;
+        }
+    } else {
+        if (a != 1 || c != 1) {
+            return false;
+        }
+        int k = 0;
+        for (const Term& term : nonzero) {
+            k = gcd(k, term.power - shift);
+        }
+        Dense q((nonzero.back().power - shift) / k + 1, 0);
+        for (const Term& term : nonzero) {
+            q[(term.power - shift) / k] = sign * (long long) term.coefficient;
+        }
+        if (!deflatedFactors(q, k, result)) {
+            return false;
+        }
+    }
+    factors.insert(factors.end(), result.begin(), result.end());
+    return true;
+}
@@ -0,0 +1,50 @@
+#ifndef CYCLOTOMIC_H
+#define CYCLOTOMIC_H
+
+#include <vector>
+#include "polynomial.h"
+
+/**
+ * Factorization by formula of binomials and cyclotomic polynomials.
+ *
+ * u^N - v^N is the product over the divisors d of N of the homogenized
+ * cyclotomic polynomials v^phi(d) Phi_d(u / v), each irreducible, so a
+ * binomial a x^n + c whose coefficients are both n-th powers, up to sign,
+ * factors without any search, and so does x^n - 1 for any n. Likewise a
+ * polynomial that is Phi_m(x^k) splits into the Phi_d(x) for the d whose
+ * primitive d-th roots of unity have k-th powers of order m.
+ *
+ * Phi_n itself is generated from the product over d | n of
+ * (1 - x^d)^mu(n / d), taken as a power series, and only for the product
+ * of the distinct primes of n: with r that product,
+ * Phi_n(x) = Phi_r(x^(n / r)).
+ */
+
+/**
+ * The largest degree of a polynomial that is checked for being
+ * Phi_m(x^k), which takes a table of totients up to about six times the
+ * degree of the polynomial in x^k.
+ */
+const int maxCyclotomicDegree = 1 << 20;
+
+/**
+ * The n-th cyclotomic polynomial.
+ *
+ * @param n a positive integer
+ * @return Phi_n, or Polynomial() if a coefficient does not fit in an int
+ */
+Polynomial cyclotomic(int n);
+
+/**
+ * Factor p by formula, if it is x^k times a binomial with power
+ * coefficients or times Phi_m(x^j) for some m and j.
+ *
+ * @param p a primitive polynomial
+ * @param factors output: the irreducible factors of p, each primitive
+ *                with a positive leading coefficient, repeated according
+ *                to multiplicity; their product is p up to sign
+ * @return false, leaving factors as it was, if p is of neither form
+ */
+bool factorCyclotomic(const Polynomial& p, std::vector<Polynomial>& factors);
+
+#endif
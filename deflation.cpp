@@ -0,0 +1,36 @@
+#include "deflation.h"
+#include <climits>
+#include <numeric>
+#include <vector>
+
+using namespace std;
+
+
+int exponentGcd(const Polynomial& p) {
+    int k = 0;
+    for (const Term& term : p) {
+        if (term.coefficient != 0) {
+            k = gcd(k, term.power);
+        }
+    }
+    return k;
+}
+
+Polynomial deflate(const Polynomial& p, int k) {
+    vector<Term> terms;
+    for (const Term& term : p) {
+        terms.emplace_back(term.coefficient, term.power / k);
+    }
+    return Polynomial(terms);
+}
+
+Polynomial inflate(const Polynomial& q, int k) {
+    if ((long long) q.getDegree() * k > INT_MAX) {
+        return Polynomial();
+    }
+    vector<Term> terms;
+    for (const Term& term : q) {
+        terms.emplace_back(term.coefficient, term.power * k);
+    }
+    return Polynomial(terms);
+}
@@ -0,0 +1,34 @@
+#ifndef DEFLATION_H
+#define DEFLATION_H
+
+#include "polynomial.h"
+
+/**
+ * Polynomials in x^k. When every power of p is a multiple of k > 1,
+ * p(x) = q(x^k) for the polynomial q of a k-th of the degree, which is
+ * factored first. Each factor f of q gives the factor f(x^k) of p, which
+ * is split further on its own, so the search never runs at the full
+ * degree of p.
+ */
+
+/**
+ * @return the greatest common divisor of the powers of the terms of p,
+ *         which is 0 for a constant
+ */
+int exponentGcd(const Polynomial& p);
+
+/**
+ * @param p a polynomial whose powers are all multiples of k
+ * @param k a positive integer
+ * @return q such that p(x) == q(x^k)
+ */
+Polynomial deflate(const Polynomial& p, int k);
+
+/**
+ * @param q a polynomial
+ * @param k a positive integer
+ * @return q(x^k), or Polynomial() if its degree does not fit in an int
+ */
+Polynomial inflate(const Polynomial& q, int k);
+
+#endif
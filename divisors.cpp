@@ -0,0 +1,195 @@
+#include "divisors.h"
+#include <algorithm>
+#include <numeric>
+
+using namespace std;
+
+
+typedef unsigned __int128 WideUnsigned;
+
+static unsigned long long mulModWide(unsigned long long x, unsigned long long y,
+                                     unsigned long long m) {
+    return (unsigned long long) ((WideUnsigned) x * y % m);
+}
+
+static unsigned long long powModWide(unsigned long long base, unsigned long long exponent,
+                                     unsigned long long m) {
+    unsigned long long result = 1 % m;
+    base %= m;
+    while (exponent > 0) {
+        if (exponent & 1) {
+            result = mulModWide(result, base, m);
+        }
+        base = mulModWide(base, base, m);
+        exponent >>= 1;
+    }
+    return result;
+}
+
+static const vector<unsigned>& smallPrimes() {
+    static vector<unsigned> primes;
+    if (primes.empty()) {
+        const unsigned limit = 1 << 16;
+        vector<bool> composite(limit, false);
+        for (unsigned i = 2; i < limit; ++i) {
+            if (!composite[i]) {
+                primes.push_back(i);
+                for (unsigned j = i * i; j < limit; j += i) {
+                    composite[j] = true;
+                }
+            }
+        }
+    }
+    return primes;
+}
+
+bool isPrime(unsigned long long n) {
+    if (n < 2) {
+        return false;
+    }
+    for (unsigned p : {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37}) {
+        if (n % p == 0) {
+            return n == p;
+        }
+    }
+    unsigned long long d = n - 1;
+    int s = 0;
+    while (d % 2 == 0) {
+        d /= 2;
+        ++s;
+    }
+    // These bases are a proof of primality for every n < 3.3 * 10^24.
+    for (unsigned long long a : {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37}) {
+        unsigned long long x = powModWide(a, d, n);
+        if (x == 1 || x == n - 1) {
+            continue;
+        }
+        bool witness = true;
+        for (int r = 1; r < s && witness; ++r) {
+            x = mulModWide(x, x, n);
+            if (x == n - 1) {
+                witness = false;
+            }
+        }
+        if (witness) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * A nontrivial factor of the odd composite n, by Brent's cycle-finding
+ * variant of Pollard's rho with batched gcds.
+ */
+static unsigned long long pollardRho(unsigned long long n) {
+    for (unsigned long long c = 1;; ++c) {
+        auto f = [n, c](unsigned long long x) {
+            return (unsigned long long) (((WideUnsigned) x * x + c) % n);
+        };
+        unsigned long long y = 2, x = 2, saved = 2, g = 1, product = 1;
+        const unsigned long long batch = 128;
+        for (unsigned long long r = 1; g == 1; r *= 2) {
+            x = y;
+            for (unsigned long long i = 0; i < r; ++i) {
+                y = f(y);
+            }
+            for (unsigned long long k = 0; k < r && g == 1; k += batch) {
+                saved = y;
+                for (unsigned long long i = 0; i < min(batch, r - k); ++i) {
+                    y = f(y);
+                    product = mulModWide(product, (x > y) ? x - y : y - x, n);
+                }
+                g = gcd(product, n);
+            }
+        }
+        if (g == n) {
+            // The batch overshot; redo it one step at a time.
+            do {
+                saved = f(saved);
+                g = gcd((x > saved) ? x - saved : saved - x, n);
+            } while (g == 1);
+        }
+        if (g != n) {
+            return g;
+        }
+    }
+}
+
+static void collectPrimeFactors(unsigned long long n, vector<unsigned long long>& primes) {
+    if (n == 1) {
+        return;
+    }
+    if (isPrime(n)) {
+        primes.push_back(n);
+        return;
+    }
+    unsigned long long d = pollardRho(n);
+    collectPrimeFactors(d, primes);
+    collectPrimeFactors(n / d, primes);
+}
+
+vector<pair<unsigned long long, int>> factorInteger(unsigned long long n) {
+    vector<pair<unsigned long long, int>> factors;
+    if (n < 2) {
+        return factors;
+    }
+    for (unsigned p : smallPrimes()) {
+        if ((unsigned long long) p * p > n) {
+            break;
+        }
+        if (n % p == 0) {
+            int exponent = 0;
+            while (n % p == 0) {
+                n /= p;
+                ++exponent;
+            }
+            factors.emplace_back(p, exponent);
+        }
+    }
+    if (n > 1) {
+        // Every prime factor left is at least 2^16.
+        vector<unsigned long long> large;
+        collectPrimeFactors(n, large);
+        sort(large.begin(), large.end());
+        for (unsigned long long p : large) {
+            if (!factors.empty() && factors.back().first == p) {
+                ++factors.back().second;
+            } else {
+                factors.emplace_back(p, 1);
+            }
+        }
+    }
+    return factors;
+}
+
+vector<unsigned long long> divisorsOf(unsigned long long n) {
+    vector<unsigned long long> divisors;
+    if (n == 0) {
+        return divisors;
+    }
+    divisors.push_back(1);
+    for (const auto& factor : factorInteger(n)) {
+        size_t count = divisors.size();
+        unsigned long long power = 1;
+        for (int e = 1; e <= factor.second; ++e) {
+            power *= factor.first;
+            for (size_t i = 0; i < count; ++i) {
+                divisors.push_back(divisors[i] * power);
+            }
+        }
+    }
+    sort(divisors.begin(), divisors.end());
+    return divisors;
+}
+
+unsigned long long divisorCount(unsigned long long n) {
+    if (n == 0) {
+        return 0;
+    }
+    unsigned long long count = 1;
+    for (const auto& factor : factorInteger(n)) {
+        count *= factor.second + 1;
+    }
+    return count;
+}
@@ -0,0 +1,46 @@
+#ifndef DIVISORS_H
+#define DIVISORS_H
+
+#include <utility>
+#include <vector>
+
+/**
+ * Integer factorization and divisor enumeration, used to generate the
+ * candidate linear factors ax + b of a polynomial from the divisors of
+ * its leading and constant coefficients.
+ */
+
+/**
+ * Deterministic Miller-Rabin primality test, valid for all 64-bit n.
+ */
+bool isPrime(unsigned long long n);
+
+/**
+ * Factor n into primes: trial division by a precomputed table of the
+ * primes below 2^16, then Pollard's rho (Brent's variant) on whatever
+ * cofactor remains.
+ *
+ * @param n the number to factor
+ * @return (prime, exponent) pairs in increasing order of prime; empty if n < 2
+ */
+std::vector<std::pair<unsigned long long, int>> factorInteger(unsigned long long n);
+
+/**
+ * All positive divisors of n, in increasing order, generated from its
+ * prime factorization.
+ *
+ * @param n a positive integer
+ * @return the divisors of n; empty if n == 0
+ */
+std::vector<unsigned long long> divisorsOf(unsigned long long n);
+
+/**
+ * The number of positive divisors of n, from its prime factorization,
+ * without enumerating them.
+ *
+ * @param n a positive integer
+ * @return the size of divisorsOf(n); 0 if n == 0
+ */
+unsigned long long divisorCount(unsigned long long n);
+
+#endif
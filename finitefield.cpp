@@ -0,0 +1,310 @@
+#include "finitefield.h"
+#include <algorithm>
+
+using namespace std;
+
+
+// Distinct-degree factorization takes one gcd per this many degrees, of
+// the product of the polynomials x^(p^d) - x, rather than one per degree.
+static const int gcdBlock = 16;
+
+static ModPolynomial constant(Residue m, Residue c) {
+    return ModPolynomial(m, vector<Residue>{c});
+}
+
+/**
+ * The coefficients of a of the powers from first up to (not including)
+ * last, as a polynomial starting at x^0.
+ */
+static ModPolynomial slice(const ModPolynomial& a, int first, int last) {
+    vector<Residue> c;
+    for (int i = first; i < last; ++i) {
+        c.push_back(a.getCoeff(i));
+    }
+    return ModPolynomial(a.getModulus(), c);
+}
+
+/**
+ * Whether f precedes g in the order factors are listed: by degree, then
+ * by coefficients from the highest power down.
+ */
+static bool precedes(const ModPolynomial& f, const ModPolynomial& g) {
+    if (f.getDegree() != g.getDegree()) {
+        return f.getDegree() < g.getDegree();
+    }
+    for (int i = f.getDegree(); i >= 0; --i) {
+        if (f.getCoeff(i) != g.getCoeff(i)) {
+            return f.getCoeff(i) < g.getCoeff(i);
+        }
+    }
+    return false;
+}
+
+
+PolynomialModulus::PolynomialModulus(const ModPolynomial& f)
+    : f(f), mu(f.getModulus()) {
+    int n = f.getDegree();
+    vector<Residue> power(2 * n + 1, 0);
+    power[2 * n] = 1;
+    mu = ModPolynomial(f.getModulus(), power) / f;
+}
+
+const ModPolynomial& PolynomialModulus::getPolynomial() const {
+    return f;
+}
+
+/**
+ * @param a a polynomial with the same modulus
+ * @return a mod f
+ */
+ModPolynomial PolynomialModulus::reduce(const ModPolynomial& a) const {
+    int n = f.getDegree();
+    if (a.getDegree() < n) {
+        return a;
+    }
+    if (a.getDegree() >= 2 * n) {
+        return a % f;
+    }
+    ModPolynomial quotient = slice(slice(a, n, 2 * n) * mu, n, 2 * n);
+    return slice(a - quotient * f, 0, n);
+}
+
+/**
+ * @param a a polynomial reduced modulo f
+ * @param b a polynomial reduced modulo f
+ * @return a b mod f
+ */
+ModPolynomial PolynomialModulus::multiply(const ModPolynomial& a, const ModPolynomial& b) const {
+    return reduce(a * b);
+}
+
+/**
+ * a raised to a power modulo f, by repeated squaring.
+ */
+ModPolynomial PolynomialModulus::power(const ModPolynomial& a, unsigned long long exponent) const {
+    ModPolynomial result = reduce(constant(f.getModulus(), 1));
+    ModPolynomial base = reduce(a);
+    while (exponent > 0) {
+        if (exponent & 1) {
+            result = multiply(result, base);
+        }
+        exponent >>= 1;
+        if (exponent > 0) {
+            base = multiply(base, base);
+        }
+    }
+    return result;
+}
+
+
+FrobeniusMap::FrobeniusMap(const PolynomialModulus& modulus) : modulus(modulus) {
+    const ModPolynomial& f = modulus.getPolynomial();
+    int n = f.getDegree();
+    if (n > maxFrobeniusMatrixDegree) {
+        return;
+    }
+    Residue p = f.getModulus();
+    ModPolynomial xp = modulus.power(ModPolynomial(p, {0, 1}), p);
+    ModPolynomial row = modulus.reduce(constant(p, 1));
+    for (int i = 0; i < n; ++i) {
+        rows.emplace_back(n);
+        for (int j = 0; j < n; ++j) {
+            rows[i][j] = row.getCoeff(j);
+        }
+        row = modulus.multiply(row, xp);
+    }
+}
+
+/**
+ * @param a a polynomial reduced modulo f
+ * @return a^p mod f
+ */
+ModPolynomial FrobeniusMap::operator() (const ModPolynomial& a) const {
+    const ModPolynomial& f = modulus.getPolynomial();
+    Residue p = f.getModulus();
+    if (rows.empty()) {
+        return modulus.power(a, p);
+    }
+    if (a.isZero()) {
+        return a;
+    }
+    int n = f.getDegree();
+    vector<ProductSum> sums(n);
+    for (int i = 0; i <= a.getDegree(); ++i) {
+        Residue c = a.getCoeff(i);
+        if (c == 0) {
+            continue;
+        }
+        const vector<Residue>& row = rows[i];
+        for (int j = 0; j < n; ++j) {
+            sums[j].add(c, row[j]);
+        }
+    }
+    vector<Residue> result(n);
+    for (int j = 0; j < n; ++j) {
+        result[j] = sums[j].reduce(p);
+    }
+    return ModPolynomial(p, result);
+}
+
+
+/**
+ * Yun's algorithm, adapted to characteristic p: a factor whose
+ * multiplicity is a multiple of p has a zero derivative, and is left
+ * behind in c as a polynomial in x^p, whose p-th root is split in turn.
+ */
+vector<pair<ModPolynomial, int>> squareFreeFactors(const ModPolynomial& f) {
+    vector<pair<ModPolynomial, int>> result;
+    if (f.getDegree() == 0) {
+        return result;
+    }
+    Residue p = f.getModulus();
+    ModPolynomial c = gcd(f, f.derivative());
+    ModPolynomial w = f.monic() / c;
+    for (int k = 1; w.getDegree() > 0; ++k) {
+        ModPolynomial y = gcd(w, c);
+        ModPolynomial factor = w / y;
+        if (factor.getDegree() > 0) {
+            result.emplace_back(factor, k);
+        }
+        w = y;
+        c = c / y;
+    }
+    if (c.getDegree() > 0) {
+        vector<Residue> root;
+        for (int i = 0; i <= c.getDegree(); i += p) {
+            root.push_back(c.getCoeff(i));
+        }
+        for (const pair<ModPolynomial, int>& g : squareFreeFactors(ModPolynomial(p, root))) {
+            result.emplace_back(g.first, g.second * p);
+        }
+        sort(result.begin(), result.end(),
+             [](const pair<ModPolynomial, int>& a, const pair<ModPolynomial, int>& b) {
+                 return a.second < b.second;
+             });
+    }
+    return result;
+}
+
+/**
+ * x^(p^d) is computed from x^(p^(d-1)) by the Frobenius map, and the
+ * factors of degree d are split off as gcd(f, x^(p^d) - x) once those of
+ * lower degree are gone. The gcds are taken for a block of degrees at a
+ * time, and only a block with a nontrivial gcd is looked at degree by
+ * degree. Once no factor of degree d is left, with 2d beyond the degree
+ * of what remains, what remains is irreducible.
+ */
+vector<pair<ModPolynomial, int>> distinctDegreeFactors(const ModPolynomial& f) {
+    vector<pair<ModPolynomial, int>> result;
+    Residue p = f.getModulus();
+    PolynomialModulus modulus(f);
+    FrobeniusMap frobenius(modulus);
+    ModPolynomial x = modulus.reduce(ModPolynomial(p, {0, 1}));
+    ModPolynomial power = x;
+    ModPolynomial rest = f;
+    int d = 0;
+    while (2 * (d + 1) <= rest.getDegree()) {
+        int first = d + 1;
+        vector<ModPolynomial> differences;
+        ModPolynomial product = modulus.reduce(constant(p, 1));
+        while ((int) differences.size() < gcdBlock && 2 * (d + 1) <= rest.getDegree()) {
+            ++d;
+            power = frobenius(power);
+            differences.push_back(power - x);
+            product = modulus.multiply(product, differences.back());
+        }
+        ModPolynomial common = gcd(rest, product);
+        for (size_t i = 0; i < differences.size() && common.getDegree() > 0; ++i) {
+            ModPolynomial factors = gcd(common, differences[i]);
+            if (factors.getDegree() > 0) {
+                result.emplace_back(factors, first + (int) i);
+                common = common / factors;
+                rest = rest / factors;
+            }
+        }
+    }
+    if (rest.getDegree() > 0) {
+        result.emplace_back(rest.monic(), rest.getDegree());
+    }
+    return result;
+}
+
+/**
+ * A deterministic stream of pseudo-random polynomials of degree below n.
+ */
+static ModPolynomial randomPolynomial(unsigned long long& state, int n, Residue m) {
+    vector<Residue> c(n);
+    for (Residue& x : c) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        x = (state >> 11) % m;
+    }
+    return ModPolynomial(m, c);
+}
+
+/**
+ * Cantor-Zassenhaus splitting. In the field of p^d elements that each
+ * irreducible factor of g gives, a^((p^d - 1) / 2) is 1 for half the
+ * nonzero a and -1 for the other half, so gcd(g, a^((p^d - 1) / 2) - 1)
+ * separates the factors at random. The power is taken as the
+ * ((p - 1) / 2)-th power of the norm a a^p ... a^(p^(d-1)), each factor
+ * of which is one application of the Frobenius map. For p = 2 the trace
+ * a + a^2 + ... + a^(2^(d-1)), which is 0 or 1 in each field, is used
+ * instead.
+ *
+ * @param frobenius the Frobenius map modulo a multiple of g
+ */
+static void splitEqualDegree(const ModPolynomial& g, int d, const FrobeniusMap& frobenius,
+                             unsigned long long& state, vector<ModPolynomial>& factors) {
+    if (g.getDegree() <= d) {
+        factors.push_back(g);
+        return;
+    }
+    Residue p = g.getModulus();
+    PolynomialModulus modulus(g);
+    while (true) {
+        ModPolynomial a = randomPolynomial(state, g.getDegree(), p);
+        ModPolynomial conjugate = a, split = a;
+        for (int i = 1; i < d; ++i) {
+            conjugate = modulus.reduce(frobenius(conjugate));
+            split = (p == 2) ? split + conjugate : modulus.multiply(split, conjugate);
+        }
+        if (p != 2) {
+            split = modulus.power(split, (p - 1) / 2) - constant(p, 1);
+        }
+        ModPolynomial h = gcd(g, split);
+        if (h.getDegree() > 0 && h.getDegree() < g.getDegree()) {
+            splitEqualDegree(h, d, frobenius, state, factors);
+            splitEqualDegree(g / h, d, frobenius, state, factors);
+            return;
+        }
+    }
+}
+
+vector<ModPolynomial> equalDegreeFactors(const ModPolynomial& f, int d) {
+    vector<ModPolynomial> factors;
+    if (f.getDegree() == 0) {
+        return factors;
+    }
+    PolynomialModulus modulus(f);
+    FrobeniusMap frobenius(modulus);
+    unsigned long long state = 1;
+    splitEqualDegree(f.monic(), d, frobenius, state, factors);
+    sort(factors.begin(), factors.end(), precedes);
+    return factors;
+}
+
+vector<pair<ModPolynomial, int>> factorModular(const ModPolynomial& f) {
+    vector<pair<ModPolynomial, int>> result;
+    for (const pair<ModPolynomial, int>& squareFree : squareFreeFactors(f)) {
+        for (const pair<ModPolynomial, int>& sameDegree : distinctDegreeFactors(squareFree.first)) {
+            for (const ModPolynomial& g : equalDegreeFactors(sameDegree.first, sameDegree.second)) {
+                result.emplace_back(g, squareFree.second);
+            }
+        }
+    }
+    sort(result.begin(), result.end(),
+         [](const pair<ModPolynomial, int>& a, const pair<ModPolynomial, int>& b) {
+             return precedes(a.first, b.first);
+         });
+    return result;
+}
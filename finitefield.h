@@ -0,0 +1,116 @@
+#ifndef FINITEFIELD_H
+#define FINITEFIELD_H
+
+#include <utility>
+#include <vector>
+#include "modpolynomial.h"
+
+/**
+ * Factorization of polynomials over the integers modulo a prime p, by
+ * the Cantor-Zassenhaus method:
+ *
+ *  - square-free factorization separates the factors by multiplicity;
+ *  - distinct-degree factorization splits a square-free polynomial into
+ *    the products of its irreducible factors of each degree d, as
+ *    gcd(f, x^(p^d) - x);
+ *  - equal-degree factorization splits each such product by gcds with
+ *    random polynomials raised to the power (p^d - 1) / 2.
+ *
+ * All of the work is arithmetic modulo a fixed polynomial f, which
+ * PolynomialModulus speeds up by precomputing its reduction, and powers
+ * x^(p^d), which FrobeniusMap computes from one another by a matrix
+ * product instead of by repeated squaring.
+ */
+
+/**
+ * A fixed nonzero polynomial f modulo a prime, prepared for arithmetic
+ * modulo f.
+ *
+ * Reduction is by the polynomial form of Barrett's method: with
+ * mu = x^(2n) div f precomputed once, n being the degree of f, the
+ * quotient of any a of degree below 2n is ((a div x^n) mu) div x^n, so
+ * reducing a product costs two multiplications and no division.
+ */
+class PolynomialModulus {
+public:
+    explicit PolynomialModulus(const ModPolynomial& f);
+
+    const ModPolynomial& getPolynomial() const;
+
+    ModPolynomial reduce(const ModPolynomial& a) const;
+    ModPolynomial multiply(const ModPolynomial& a, const ModPolynomial& b) const;
+    ModPolynomial power(const ModPolynomial& a, unsigned long long exponent) const;
+
+private:
+    ModPolynomial f;
+    ModPolynomial mu;
+};
+
+/**
+ * The map a -> a^p modulo a fixed polynomial f, p being the modulus of
+ * its coefficients.
+ *
+ * Over the integers modulo p, (sum a_i x^i)^p == sum a_i x^(ip), so the
+ * map is linear: its matrix has the residues of x^(ip) modulo f as rows,
+ * computed once from x^p mod f, and applying it costs n^2 multiply-adds
+ * instead of the log p squarings of powering. Beyond
+ * maxFrobeniusMatrixDegree, where the matrix would take too much memory,
+ * the map falls back to powering.
+ */
+class FrobeniusMap {
+public:
+    explicit FrobeniusMap(const PolynomialModulus& modulus);
+
+    ModPolynomial operator() (const ModPolynomial& a) const;
+
+    static const int maxFrobeniusMatrixDegree = 4096;
+
+private:
+    const PolynomialModulus& modulus;
+    std::vector<std::vector<Residue>> rows;
+};
+
+/**
+ * Split a polynomial by the multiplicities of its irreducible factors.
+ *
+ * @param f a polynomial modulo a prime
+ * @return pairs (g, k), g being the monic product of the irreducible
+ *         factors of f of multiplicity k, for each k for which there are
+ *         any, by increasing k; empty if f is constant
+ */
+std::vector<std::pair<ModPolynomial, int>> squareFreeFactors(const ModPolynomial& f);
+
+/**
+ * Split a square-free polynomial by the degrees of its irreducible
+ * factors.
+ *
+ * @param f a monic square-free polynomial modulo a prime
+ * @return pairs (g, d), g being the product of the irreducible factors
+ *         of f of degree d, for each d for which there are any, by
+ *         increasing d
+ */
+std::vector<std::pair<ModPolynomial, int>> distinctDegreeFactors(const ModPolynomial& f);
+
+/**
+ * Split a product of distinct irreducible polynomials of the same degree.
+ *
+ * The random polynomials used are drawn from a fixed stream, so the
+ * results are reproducible.
+ *
+ * @param f a monic product of distinct irreducible polynomials of degree d
+ * @param d the degree of each factor
+ * @return the monic irreducible factors of f, sorted as by factorModular
+ */
+std::vector<ModPolynomial> equalDegreeFactors(const ModPolynomial& f, int d);
+
+/**
+ * Factor a polynomial modulo a prime into irreducible factors.
+ *
+ * @param f a polynomial modulo a prime
+ * @return the monic irreducible factors of f with their multiplicities,
+ *         sorted by degree and then by coefficients from the highest
+ *         power down; empty if f is constant
+ */
+std::vector<std::pair<ModPolynomial, int>> factorModular(const ModPolynomial& f);
+
+#endif
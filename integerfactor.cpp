@@ -0,0 +1,861 @@
+#include "integerfactor.h"
+#include "divisors.h"
+#include "modarith.h"
+#include "modpolynomial.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <numeric>
+
+using namespace std;
+
+
+// Dense integer polynomials, lowest power first, with no trailing zeros.
+typedef vector<long long> Dense;
+
+// Lifted factors are kept modulo the largest power of the prime below
+// this, so that modarith's sums of residues cannot overflow.
+static const Residue liftLimit = 1ULL << 62;
+
+// The largest primes below 2^62, for the modular gcd.
+static const Residue gcdPrimes[] = {
+    4611686018427387847ULL, 4611686018427387817ULL, 4611686018427387787ULL
+};
+
+
+static void trim(Dense& d) {
+    while (!d.empty() && d.back() == 0) {
+        d.pop_back();
+    }
+}
+
+static Dense toDense(const Polynomial& p) {
+    Dense d(max(p.getDegree(), 0) + 1, 0);
+    for (const Term& term : p) {
+        d[term.power] += term.coefficient;
+    }
+    trim(d);
+    return d;
+}
+
+/**
+ * @return false if a coefficient of d does not fit in an int
+ */
+static bool toPolynomial(const Dense& d, Polynomial& p) {
+    vector<int> c;
+    for (long long x : d) {
+        if (x < INT_MIN || x > INT_MAX) {
+            return false;
+        }
+        c.push_back((int) x);
+    }
+    p = Polynomial(c.size(), c.data());
+    return true;
+}
+
+/**
+ * d divided by the gcd of its coefficients, signed to have a positive
+ * leading coefficient.
+ */
+static Dense primitivePart(Dense d) {
+    long long g = 0;
+    for (long long x : d) {
+        g = gcd(g, x);
+    }
+    if (g == 0) {
+        return d;
+    }
+    if (d.back() < 0) {
+        g = -g;
+    }
+    for (long long& x : d) {
+        x /= g;
+    }
+    return d;
+}
+
+static Dense derivative(const Dense& f) {
+    Dense d;
+    for (size_t i = 1; i < f.size(); ++i) {
+        d.push_back(f[i] * (long long) i);
+    }
+    trim(d);
+    return d;
+}
+
+/**
+ * Exact division over the integers.
+ *
+ * @param a the dividend
+ * @param b a nonzero divisor
+ * @param quotient output: a / b, if b divides a
+ * @return false if b does not divide a, or if the division overflows
+ */
+static bool divideExactly(const Dense& a, const Dense& b, Dense& quotient) {
+    if (a.size() < b.size()) {
+        return false;
+    }
+    // The constant terms rule out most non-divisors at once.
+    if ((b[0] == 0) ? a[0] != 0 : a[0] % b[0] != 0) {
+        return false;
+    }
+    vector<__int128> r(a.begin(), a.end());
+    size_t d = b.size() - 1;
+    Dense q(a.size() - d, 0);
+    for (size_t i = q.size(); i-- > 0;) {
+        if (r[i + d] % b[d] != 0) {
+            return false;
+        }
+        __int128 c = r[i + d] / b[d];
+        if (c < LLONG_MIN || c > LLONG_MAX) {
+            return false;
+        }
+        q[i] = (long long) c;
+        for (size_t j = 0; j <= d; ++j) {
+            __int128 product;
+            if (__builtin_mul_overflow(c, (__int128) b[j], &product)
+                || __builtin_sub_overflow(r[i + j], product, &r[i + j])) {
+                return false;
+            }
+        }
+    }
+    for (size_t j = 0; j < d; ++j) {
+        if (r[j] != 0) {
+            return false;
+        }
+    }
+    quotient = q;
+    return true;
+}
+
+static ModPolynomial reduce(const Dense& d, Residue m) {
+    vector<Residue> c(d.size());
+    for (size_t i = 0; i < d.size(); ++i) {
+        c[i] = toResidue(d[i], m);
+    }
+    return ModPolynomial(m, c);
+}
+
+static vector<Residue> coefficients(const ModPolynomial& p) {
+    vector<Residue> c(p.isZero() ? 0 : p.getDegree() + 1);
+    for (size_t i = 0; i < c.size(); ++i) {
+        c[i] = p.getCoeff(i);
+    }
+    return c;
+}
+
+/**
+ * The residues of p, taken modulo m instead.
+ */
+static ModPolynomial withModulus(const ModPolynomial& p, Residue m) {
+    return ModPolynomial(m, coefficients(p));
+}
+
+/**
+ * The integer polynomial whose coefficients are the symmetric
+ * representatives of those of p.
+ */
+static Dense symmetric(const ModPolynomial& p) {
+    Dense d;
+    for (Residue c : coefficients(p)) {
+        d.push_back(fromResidue(c, p.getModulus()));
+    }
+    trim(d);
+    return d;
+}
+
+/**
+ * The gcd of two integer polynomials, by reducing modulo a large prime
+ * and verifying the result by exact division.
+ *
+ * A prime not dividing lc(a) can only make the gcd bigger. So a modular
+ * gcd of degree 0 proves a and b coprime. A candidate that divides both
+ * a and b is the gcd, since its degree is at least that of the gcd.
+ *
+ * @param g output: the gcd, primitive with a positive leading coefficient
+ * @return false if no prime gave a verifiable gcd
+ */
+static bool integerGcd(const Dense& a, const Dense& b, Dense& g) {
+    for (Residue q : gcdPrimes) {
+        Residue lead = toResidue(a.back(), q);
+        if (lead == 0) {
+            continue;
+        }
+        ModPolynomial reduced = gcd(reduce(a, q), reduce(b, q));
+        if (reduced.getDegree() == 0) {
+            g = Dense(1, 1);
+            return true;
+        }
+        // The gcd's leading coefficient divides lc(a), so lc(a) times the
+        // monic modular gcd is an integer multiple of the gcd.
+        Dense candidate = primitivePart(symmetric(reduced * ModPolynomial(q, vector<Residue>{lead})));
+        Dense unused;
+        if (divideExactly(a, candidate, unused) && divideExactly(b, candidate, unused)) {
+            g = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/**
+ * A deterministic stream of pseudo-random residues modulo m.
+ */
+static Residue nextRandom(unsigned long long& state, Residue m) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return (state >> 11) % m;
+}
+
+/**
+ * Factor a monic square-free polynomial modulo an odd prime q by
+ * Berlekamp's algorithm.
+ *
+ * The polynomials v with v^q == v (mod f) form a vector space whose
+ * dimension is the number of irreducible factors of f. For a random v
+ * in that space, gcd(f, v^((q-1)/2) - 1) splits f about half the time.
+ *
+ * @param f a monic square-free polynomial of positive degree
+ * @return the monic irreducible factors of f
+ */
+static vector<ModPolynomial> berlekamp(const ModPolynomial& f) {
+    Residue q = f.getModulus();
+    int n = f.getDegree();
+
+    // Row i of Q holds x^(iq) mod f, and v^q == v exactly when
+    // (Q^T - I) v == 0; a is that matrix.
+    ModPolynomial xq = ModPolynomial(q, vector<Residue>{0, 1}).powMod(q, f);
+    vector<vector<Residue>> a(n, vector<Residue>(n, 0));
+    ModPolynomial row(q, vector<Residue>{1});
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            a[j][i] = row.getCoeff(j);
+        }
+        a[i][i] = subMod(a[i][i], 1, q);
+        row = (row * xq) % f;
+    }
+
+    // Gauss-Jordan elimination, then one basis vector of the null space
+    // per column without a pivot.
+    vector<int> pivotRow(n, -1);
+    int rank = 0;
+    for (int col = 0; col < n && rank < n; ++col) {
+        int pivot = rank;
+        while (pivot < n && a[pivot][col] == 0) {
+            ++pivot;
+        }
+        if (pivot == n) {
+            continue;
+        }
+        swap(a[pivot], a[rank]);
+        Residue inverse = invMod(a[rank][col], q);
+        for (Residue& c : a[rank]) {
+            c = mulMod(c, inverse, q);
+        }
+        for (int r = 0; r < n; ++r) {
+            Residue factor = a[r][col];
+            if (r == rank || factor == 0) {
+                continue;
+            }
+            for (int c = col; c < n; ++c) {
+                a[r][c] = subMod(a[r][c], mulMod(factor, a[rank][c], q), q);
+            }
+        }
+        pivotRow[col] = rank++;
+    }
+    vector<vector<Residue>> basis;
+    for (int free = 0; free < n; ++free) {
+        if (pivotRow[free] >= 0) {
+            continue;
+        }
+        vector<Residue> v(n, 0);
+        v[free] = 1;
+        for (int col = 0; col < n; ++col) {
+            if (pivotRow[col] >= 0) {
+                v[col] = subMod(0, a[pivotRow[col]][free], q);
+            }
+        }
+        basis.push_back(v);
+    }
+
+    vector<ModPolynomial> factors(1, f);
+    ModPolynomial one(q, vector<Residue>{1});
+    unsigned long long state = 1;
+    while (factors.size() < basis.size()) {
+        vector<Residue> w(n, 0);
+        for (const vector<Residue>& v : basis) {
+            Residue c = nextRandom(state, q);
+            for (int i = 0; i < n; ++i) {
+                w[i] = addMod(w[i], mulMod(c, v[i], q), q);
+            }
+        }
+        ModPolynomial random(q, w);
+        for (size_t i = 0; i < factors.size() && factors.size() < basis.size(); ++i) {
+            ModPolynomial g = factors[i];
+            if (g.getDegree() <= 1) {
+                continue;
+            }
+            ModPolynomial d = gcd(g, random.powMod((q - 1) / 2, g) - one);
+            if (d.getDegree() > 0 && d.getDegree() < g.getDegree()) {
+                factors[i] = d;
+                factors.push_back((g / d).monic());
+            }
+        }
+    }
+    return factors;
+}
+
+/**
+ * Factor u modulo the first few primes that do not divide its leading
+ * coefficient and modulo which it stays square-free.
+ *
+ * @param u a square-free polynomial of positive degree
+ * @param prime output: the prime giving the fewest factors
+ * @param factors output: the monic factors of u modulo that prime
+ * @param possible output: possible[d] is false if u certainly has no
+ *                 factor of degree d, because for some prime no subset
+ *                 of the modular factors has degree d
+ * @return false if no suitable prime was found
+ */
+static bool factorModPrimes(const Dense& u, Residue& prime, vector<ModPolynomial>& factors,
+                            vector<bool>& possible) {
+    int n = u.size() - 1;
+    possible.assign(n + 1, true);
+    factors.clear();
+    int tried = 0;
+    for (Residue q = factorPrimeLimit - 1; q > 2 && tried < factorPrimeTrials; --q) {
+        if (!isPrime(q) || toResidue(u.back(), q) == 0) {
+            continue;
+        }
+        ModPolynomial reduced = reduce(u, q);
+        if (gcd(reduced, reduced.derivative()).getDegree() > 0) {
+            continue;
+        }
+        ++tried;
+        vector<ModPolynomial> modular = berlekamp(reduced.monic());
+        vector<bool> sums(n + 1, false);
+        sums[0] = true;
+        for (const ModPolynomial& g : modular) {
+            int d = g.getDegree();
+            for (int s = n - d; s >= 0; --s) {
+                if (sums[s]) {
+                    sums[s + d] = true;
+                }
+            }
+        }
+        for (int d = 0; d <= n; ++d) {
+            possible[d] = possible[d] && sums[d];
+        }
+        if (factors.empty() || modular.size() < factors.size()) {
+            factors = modular;
+            prime = q;
+        }
+        if (modular.size() == 1) {
+            break;
+        }
+    }
+    return tried > 0;
+}
+
+static bool onlyTrivialDegrees(const vector<bool>& possible) {
+    for (size_t d = 1; d + 1 < possible.size(); ++d) {
+        if (possible[d]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Whether a polynomial is certainly irreducible by the degrees of its
+ * factors modulo a few primes.
+ */
+static bool certifiedIrreducible(const Dense& u) {
+    if (u.size() <= 2) {
+        return true;
+    }
+    Residue prime;
+    vector<ModPolynomial> factors;
+    vector<bool> possible;
+    return factorModPrimes(u, prime, factors, possible)
+        && (factors.size() == 1 || onlyTrivialDegrees(possible));
+}
+
+
+/**
+ * s and t with s a + t b == 1, for a and b coprime modulo a prime.
+ */
+static void extendedGcd(const ModPolynomial& a, const ModPolynomial& b,
+                        ModPolynomial& s, ModPolynomial& t) {
+    Residue q = a.getModulus();
+    ModPolynomial r0 = a, r1 = b;
+    ModPolynomial s0(q, vector<Residue>{1}), s1(q), t0(q), t1(q, vector<Residue>{1});
+    while (!r1.isZero()) {
+        ModPolynomial quotient(q), remainder(q);
+        r0.divide(r1, quotient, remainder);
+        r0 = r1;
+        r1 = remainder;
+        ModPolynomial s2 = s0 - quotient * s1;
+        s0 = s1;
+        s1 = s2;
+        ModPolynomial t2 = t0 - quotient * t1;
+        t0 = t1;
+        t1 = t2;
+    }
+    ModPolynomial scale(q, vector<Residue>{invMod(r0.getCoeff(0), q)});
+    s = s0 * scale;
+    t = t0 * scale;
+}
+
+/**
+ * Lift a factorization v == g h modulo q, with g monic and coprime to h
+ * modulo q, to one modulo m = q^k by k - 1 linear Hensel steps.
+ *
+ * Each step writes v - g h = q^j e and corrects g and h by q^j sigma and
+ * q^j tau, where sigma h + tau g == e (mod q) and deg sigma < deg g.
+ *
+ * @param v the polynomial, modulo m
+ * @param g in: a monic factor modulo q; out: its lift modulo m
+ * @param h in: the cofactor modulo q; out: its lift modulo m, with the
+ *          same leading coefficient as v
+ */
+static void liftPair(const ModPolynomial& v, ModPolynomial& g, ModPolynomial& h, Residue q, int k) {
+    Residue m = v.getModulus();
+    ModPolynomial s(q), t(q);
+    extendedGcd(g, h, s, t);
+    vector<Residue> hc = coefficients(h);
+    hc.back() = v.getCoeff(v.getDegree());
+    ModPolynomial lg = withModulus(g, m), lh(m, hc);
+    Residue power = 1;
+    for (int j = 1; j < k; ++j) {
+        power *= q;
+        vector<Residue> e = coefficients(v - lg * lh);
+        for (Residue& c : e) {
+            c = (c / power) % q;
+        }
+        ModPolynomial error(q, e);
+        ModPolynomial sigma = (t * error) % g;
+        ModPolynomial tau = (error - sigma * h) / g;
+        ModPolynomial scale(m, vector<Residue>{power});
+        lg = lg + withModulus(sigma, m) * scale;
+        lh = lh + withModulus(tau, m) * scale;
+    }
+    g = lg;
+    h = lh;
+}
+
+/**
+ * Lift a factorization u == lc(u) f_1 ... f_r modulo q, with the f_i
+ * monic and pairwise coprime, to one modulo m = q^k. Each factor in turn
+ * is lifted against the product of those after it.
+ *
+ * @param factors in: the f_i modulo q; out: their lifts modulo m
+ */
+static void henselLift(const Dense& u, vector<ModPolynomial>& factors, Residue q, int k, Residue m) {
+    ModPolynomial v = reduce(u, m);
+    for (size_t i = 0; i + 1 < factors.size(); ++i) {
+        ModPolynomial g = factors[i];
+        ModPolynomial h(q, vector<Residue>{v.getCoeff(v.getDegree()) % q});
+        for (size_t j = i + 1; j < factors.size(); ++j) {
+            h = h * factors[j];
+        }
+        liftPair(v, g, h, q, k);
+        factors[i] = g;
+        v = h;
+    }
+    factors.back() = v.monic();
+}
+
+/**
+ * Advance subset to the next k-subset of {0, ..., n-1} in lexicographic
+ * order.
+ *
+ * @return false if subset was the last one
+ */
+static bool nextSubset(vector<size_t>& subset, size_t n) {
+    size_t k = subset.size();
+    for (size_t i = k; i-- > 0;) {
+        if (subset[i] < n - k + i) {
+            ++subset[i];
+            for (size_t j = i + 1; j < k; ++j) {
+                subset[j] = subset[j - 1] + 1;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Zassenhaus recombination: try the products of subsets of the lifted
+ * factors, smallest subsets first, as divisors of u. Multiplying by lc(u)
+ * makes the product of the factors of any true factor g congruent to
+ * (lc(u) / lc(g)) g, so its primitive part is g itself once the modulus
+ * is large enough.
+ *
+ * @param u a square-free primitive polynomial
+ * @param lifted the monic factors of u modulo m
+ * @param possible the possible degrees of the factors of u
+ * @param found output: the factors found are appended to this
+ * @return what is left of u, which no subset of the remaining factors
+ *         divides
+ */
+static Dense recombine(Dense u, vector<ModPolynomial> lifted, const vector<bool>& possible,
+                       vector<Dense>& found) {
+    Residue m = lifted[0].getModulus();
+    size_t size = 1;
+    while (2 * size <= lifted.size()) {
+        bool split = false;
+        vector<size_t> subset(size);
+        iota(subset.begin(), subset.end(), 0);
+        do {
+            int degree = 0;
+            for (size_t i : subset) {
+                degree += lifted[i].getDegree();
+            }
+            if (!possible[degree]) {
+                continue;
+            }
+            ModPolynomial product(m, vector<Residue>{toResidue(u.back(), m)});
+            for (size_t i : subset) {
+                product = product * lifted[i];
+            }
+            Dense candidate = primitivePart(symmetric(product));
+            Dense quotient;
+            if (divideExactly(u, candidate, quotient)) {
+                found.push_back(candidate);
+                u = quotient;
+                for (size_t i = subset.size(); i-- > 0;) {
+                    lifted.erase(lifted.begin() + subset[i]);
+                }
+                split = true;
+                break;
+            }
+        } while (nextSubset(subset, lifted.size()));
+        if (!split) {
+            ++size;
+        }
+    }
+    return u;
+}
+
+// Rows of a lattice basis, with real entries.
+typedef vector<long double> Row;
+
+static long double dot(const Row& a, const Row& b) {
+    long double sum = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+/**
+ * LLL-reduce the rows of basis in place, with delta = 0.99, in floating
+ * point. The Gram-Schmidt data of each row is recomputed from the rows
+ * before it whenever the row changes, rather than updated, to keep the
+ * rounding errors from piling up.
+ *
+ * @param basis linearly independent rows
+ * @return the squared norms of the Gram-Schmidt vectors of the reduced
+ *         basis
+ */
+static vector<long double> reduceLattice(vector<Row>& basis) {
+    size_t d = basis.size();
+    vector<Row> star(d), mu(d, Row(d, 0));
+    vector<long double> norms(d);
+    auto orthogonalize = [&](size_t k) {
+        star[k] = basis[k];
+        for (size_t j = 0; j < k; ++j) {
+            mu[k][j] = dot(basis[k], star[j]) / norms[j];
+            for (size_t i = 0; i < star[k].size(); ++i) {
+                star[k][i] -= mu[k][j] * star[j][i];
+            }
+        }
+        norms[k] = dot(star[k], star[k]);
+    };
+
+    orthogonalize(0);
+    size_t k = 1;
+    while (k < d) {
+        orthogonalize(k);
+        bool changed = false;
+        for (size_t j = k; j-- > 0;) {
+            long double q = roundl(mu[k][j]);
+            if (q != 0) {
+                for (size_t i = 0; i < basis[k].size(); ++i) {
+                    basis[k][i] -= q * basis[j][i];
+                }
+                for (size_t i = 0; i < j; ++i) {
+                    mu[k][i] -= q * mu[j][i];
+                }
+                mu[k][j] -= q;
+                changed = true;
+            }
+        }
+        if (changed) {
+            orthogonalize(k);
+        }
+        if (norms[k] >= (0.99L - mu[k][k - 1] * mu[k][k - 1]) * norms[k - 1]) {
+            ++k;
+        } else {
+            swap(basis[k], basis[k - 1]);
+            if (k == 1) {
+                orthogonalize(0);
+            } else {
+                --k;
+            }
+        }
+    }
+    return norms;
+}
+
+/**
+ * The power sums of the roots of a monic polynomial f, scaled by powers
+ * of lead: lead^j (r_1^j + ... + r_d^j) for j = 1, ..., count, modulo
+ * that of f. By Newton's identities, with f = x^d + c_1 x^(d-1) + ... ,
+ * P_j = -j c_j - (c_1 P_(j-1) + ... + c_(j-1) P_1).
+ */
+static vector<Residue> scaledPowerSums(const ModPolynomial& f, Residue lead, size_t count) {
+    Residue m = f.getModulus();
+    int d = f.getDegree();
+    vector<Residue> sums(count + 1, 0);
+    for (size_t j = 1; j <= count; ++j) {
+        Residue sum = ((int) j <= d) ? mulMod(j % m, f.getCoeff(d - j), m) : 0;
+        for (size_t i = 1; i < j && (int) i <= d; ++i) {
+            sum = addMod(sum, mulMod(f.getCoeff(d - i), sums[j - i], m), m);
+        }
+        sums[j] = subMod(0, sum, m);
+    }
+    Residue scale = 1;
+    for (size_t j = 1; j <= count; ++j) {
+        scale = mulMod(scale, lead, m);
+        sums[j - 1] = mulMod(sums[j], scale, m);
+    }
+    sums.pop_back();
+    return sums;
+}
+
+/**
+ * van Hoeij's recombination: find which subsets of the lifted factors
+ * multiply to true factors by lattice reduction, instead of by trying
+ * the subsets.
+ *
+ * A true factor g of u, with roots among those of u, has power sums
+ * P_j(g) with lc(u)^j P_j(g) an integer of size at most
+ * deg(u) (|lc(u)| B)^j, B being a bound on the roots of u. Those of the
+ * lifted factors, scaled alike, are residues modulo m that add up to it
+ * over the factors of g. So the lattice spanned by the rows
+ *
+ *     (e_i, t_i1 / D_1, ..., t_ic / D_c)   for each lifted factor i,
+ *     (0, ..., m / D_j, ..., 0)           for each power j,
+ *
+ * where t_ij is the scaled j-th power sum of factor i and D_j the bound
+ * for it, contains for each true factor a vector that is the indicator
+ * of its subset followed by entries at most 1: a vector of squared norm
+ * at most r + c. Any such vector lies in the span of the first s rows of
+ * a basis whose later Gram-Schmidt vectors are all longer than that. If
+ * after reduction those s rows are constant on exactly s classes of
+ * factors, the classes are the subsets of the true factors, each of
+ * which is then irreducible. If not, more power sums are brought in.
+ *
+ * @param u a square-free primitive polynomial
+ * @param lifted the monic factors of u modulo m
+ * @param found output: the irreducible factors of u, if successful
+ * @return false if the power sums available at this modulus did not
+ *         determine the factors
+ */
+static bool latticeRecombine(const Dense& u, const vector<ModPolynomial>& lifted, vector<Dense>& found) {
+    size_t r = lifted.size();
+    Residue m = lifted[0].getModulus();
+    size_t n = u.size() - 1;
+    long double lead = fabsl(u.back());
+    long double rootBound = 0;
+    for (size_t i = 1; i <= n; ++i) {
+        rootBound = max(rootBound, powl(fabsl((long double) u[n - i] / lead), 1.0L / i));
+    }
+    rootBound = max(2 * rootBound, 1.0L);
+
+    // The j-th power sums are usable while their bound leaves a good
+    // margin below m.
+    vector<long double> bounds;
+    for (long double b = n * lead * rootBound; bounds.size() < n && b * (1 << 20) < m;
+         b *= lead * rootBound) {
+        bounds.push_back(b);
+    }
+    if (bounds.empty()) {
+        return false;
+    }
+    Residue leadResidue = toResidue(u.back(), m);
+    vector<vector<Residue>> sums;
+    for (const ModPolynomial& f : lifted) {
+        sums.push_back(scaledPowerSums(f, leadResidue, bounds.size()));
+    }
+
+    for (size_t c = 1;; c = min(2 * c, bounds.size())) {
+        size_t d = r + c;
+        vector<Row> basis(d, Row(d, 0));
+        for (size_t i = 0; i < r; ++i) {
+            basis[i][i] = 1;
+            for (size_t j = 0; j < c; ++j) {
+                basis[i][r + j] = fromResidue(sums[i][j], m) / bounds[j];
+            }
+        }
+        for (size_t j = 0; j < c; ++j) {
+            basis[r + j][r + j] = m / bounds[j];
+        }
+        vector<long double> norms = reduceLattice(basis);
+        size_t s = d;
+        while (s > 0 && norms[s - 1] > (r + c) * 1.001L) {
+            --s;
+        }
+
+        // Factors belong together if the first s rows agree on them.
+        vector<vector<long long>> columns(r);
+        for (size_t i = 0; i < r; ++i) {
+            for (size_t row = 0; row < s; ++row) {
+                columns[i].push_back(llroundl(basis[row][i]));
+            }
+        }
+        vector<vector<long long>> classes = columns;
+        sort(classes.begin(), classes.end());
+        classes.erase(unique(classes.begin(), classes.end()), classes.end());
+        if (s > 0 && classes.size() == s) {
+            Dense rest = u;
+            vector<Dense> factors;
+            for (const vector<long long>& cls : classes) {
+                ModPolynomial product(m, vector<Residue>{leadResidue});
+                for (size_t i = 0; i < r; ++i) {
+                    if (columns[i] == cls) {
+                        product = product * lifted[i];
+                    }
+                }
+                Dense candidate = primitivePart(symmetric(product)), quotient;
+                if (!divideExactly(rest, candidate, quotient)) {
+                    break;
+                }
+                factors.push_back(candidate);
+                rest = quotient;
+            }
+            if (factors.size() == s) {
+                found.insert(found.end(), factors.begin(), factors.end());
+                return true;
+            }
+        }
+        if (c == bounds.size()) {
+            return false;
+        }
+    }
+}
+
+/**
+ * Split a square-free primitive polynomial into irreducible factors.
+ *
+ * @param u the polynomial
+ * @param irreducible output: factors proven irreducible are appended
+ * @param uncertain output: factors that are not are appended
+ */
+static void factorSquareFree(const Dense& u, vector<Dense>& irreducible, vector<Dense>& uncertain) {
+    if (u.size() <= 2) {
+        irreducible.push_back(u);
+        return;
+    }
+    Residue q;
+    vector<ModPolynomial> modular;
+    vector<bool> possible;
+    if (!factorModPrimes(u, q, modular, possible)) {
+        uncertain.push_back(u);
+        return;
+    }
+    if (modular.size() == 1 || onlyTrivialDegrees(possible)) {
+        irreducible.push_back(u);
+        return;
+    }
+
+    int k = 1;
+    Residue m = q;
+    while (m < liftLimit / q) {
+        m *= q;
+        ++k;
+    }
+    henselLift(u, modular, q, k, m);
+
+    // By the Landau-Mignotte bound, every coefficient of lc(u)/lc(g) g is
+    // at most 2^deg(u) ||u||_2 for any factor g of u. If twice that is
+    // below m, subset testing misses no factor, so every piece it leaves
+    // is irreducible. Otherwise lattice reduction, whose bounds are on
+    // power sums instead, may still settle the factorization; failing
+    // that, a piece smaller than u is factored again, against its own,
+    // smaller bound.
+    long double norm = 0;
+    for (long long c : u) {
+        norm += (long double) c * c;
+    }
+    bool precise = 2 * ldexp(sqrt(norm), u.size() - 1) < m;
+    if ((modular.size() >= latticeFactorThreshold || !precise)
+        && latticeRecombine(u, modular, irreducible)) {
+        return;
+    }
+    vector<Dense> pieces;
+    Dense left = recombine(u, modular, possible, pieces);
+    if (left.size() > 1) {
+        pieces.push_back(primitivePart(left));
+    }
+    for (const Dense& piece : pieces) {
+        if (precise) {
+            irreducible.push_back(piece);
+        } else if (piece.size() < u.size()) {
+            factorSquareFree(piece, irreducible, uncertain);
+        } else if (certifiedIrreducible(piece)) {
+            irreducible.push_back(piece);
+        } else {
+            uncertain.push_back(piece);
+        }
+    }
+}
+
+
+void factorOverIntegers(const Polynomial& p, vector<Polynomial>& factors, Polynomial& rest) {
+    factors.clear();
+    rest = Polynomial(1);
+    Dense f = toDense(p);
+    if (f.size() < 2) {
+        return;
+    }
+    f = primitivePart(f);
+    Polynomial primitive;
+    toPolynomial(f, primitive);
+
+    // f / gcd(f, f') is the product of the distinct irreducible factors
+    // of f, each once.
+    Dense g, u;
+    if (!integerGcd(f, derivative(f), g) || !divideExactly(f, g, u)) {
+        rest = primitive;
+        return;
+    }
+    vector<Dense> irreducible, uncertain;
+    factorSquareFree(primitivePart(u), irreducible, uncertain);
+
+    Dense remaining = f;
+    vector<Dense> result;
+    for (const Dense& h : irreducible) {
+        Dense quotient;
+        while (divideExactly(remaining, h, quotient)) {
+            result.push_back(h);
+            remaining = quotient;
+        }
+    }
+    for (const Dense& h : result) {
+        Polynomial factor;
+        if (!toPolynomial(h, factor)) {
+            factors.clear();
+            rest = primitive;
+            return;
+        }
+        factors.push_back(factor);
+    }
+    if (!toPolynomial(primitivePart(remaining), rest)) {
+        factors.clear();
+        rest = primitive;
+    }
+}
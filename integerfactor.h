@@ -0,0 +1,66 @@
+#ifndef INTEGERFACTOR_H
+#define INTEGERFACTOR_H
+
+#include <vector>
+#include "polynomial.h"
+
+/**
+ * Factorization of integer polynomials into irreducible factors of any
+ * degree, by the Berlekamp-Hensel-Zassenhaus method:
+ *
+ *  - the square-free part is split off with a modular gcd;
+ *  - the square-free part is factored by Berlekamp's algorithm modulo
+ *    several small primes, and the prime giving the fewest factors is
+ *    kept;
+ *  - those factors are Hensel-lifted to the largest power of the prime
+ *    that fits in a Residue;
+ *  - the lifted factors are recombined into true factors: by a lattice
+ *    reduction (van Hoeij's knapsack) when there are many of them,
+ *    otherwise, or if that does not settle the question, by testing the
+ *    products of subsets by exact division, smallest subsets first.
+ *
+ * Everything is done in 64-bit arithmetic. A factor whose coefficients
+ * do not fit in the lifted modulus cannot be found by recombination, so
+ * a part of the polynomial that recombination cannot split is reported
+ * as irreducible only if that is certified independently: the modulus is
+ * above the Landau-Mignotte bound for its factors, or lattice reduction
+ * has pinned down its factors, or the degrees of its factors modulo
+ * several primes admit no proper factor.
+ */
+
+/**
+ * The primes used are the largest ones below this limit.
+ */
+const unsigned long long factorPrimeLimit = 1ULL << 20;
+
+/**
+ * The number of primes modulo which the square-free part is factored.
+ */
+const int factorPrimeTrials = 5;
+
+/**
+ * Recombination goes through lattice reduction when the square-free part
+ * has at least this many modular factors. Subset testing takes time
+ * exponential in their number, so this is what keeps inputs such as
+ * Swinnerton-Dyer polynomials, which split into many factors modulo
+ * every prime, from taking forever. Lattice reduction is also tried
+ * with fewer factors when the modulus is too small for subset testing
+ * to be conclusive.
+ */
+const size_t latticeFactorThreshold = 8;
+
+/**
+ * Factor p over the integers.
+ *
+ * @param p a polynomial
+ * @param factors output: the irreducible factors of p of positive degree,
+ *                each primitive with a positive leading coefficient,
+ *                repeated according to multiplicity
+ * @param rest output: what is left of the primitive part of p once the
+ *             factors are divided out; a constant if the factorization
+ *             is complete, otherwise a product of factors that could be
+ *             neither split nor proven irreducible
+ */
+void factorOverIntegers(const Polynomial& p, std::vector<Polynomial>& factors, Polynomial& rest);
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef INTERVAL_H
+#define INTERVAL_H
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * A closed interval of reals with double endpoints.
+ *
+ * Every operation rounds its result outward by one ulp at each end.
+ * Under round-to-nearest, each endpoint is within half an ulp of its
+ * exact value, so the result always encloses the exact result of the
+ * operation on any points of the operands. Once an endpoint overflows to
+ * infinity or becomes NaN, the interval no longer bounds anything, and
+ * callers must check isFinite before trusting it.
+ */
+struct Interval {
+    double lower;
+    double upper;
+
+    explicit Interval(double point) : lower(point), upper(point) {}
+    Interval(double lower, double upper) : lower(lower), upper(upper) {}
+
+    bool isFinite() const {
+        return std::isfinite(lower) && std::isfinite(upper);
+    }
+
+    bool contains(double x) const {
+        return lower <= x && x <= upper;
+    }
+};
+
+inline Interval outward(double lower, double upper)
+{
+    return Interval(std::nextafter(lower, -INFINITY), std::nextafter(upper, INFINITY));
+}
+
+inline Interval operator+ (const Interval& x, const Interval& y)
+{
+    return outward(x.lower + y.lower, x.upper + y.upper);
+}
+
+inline Interval operator* (const Interval& x, const Interval& y)
+{
+    double ll = x.lower * y.lower, lu = x.lower * y.upper;
+    double ul = x.upper * y.lower, uu = x.upper * y.upper;
+    return outward(std::min(std::min(ll, lu), std::min(ul, uu)),
+                   std::max(std::max(ll, lu), std::max(ul, uu)));
+}
+
+#endif
@@ -0,0 +1,241 @@
+#include "lowdegree.h"
+#include <climits>
+#include <cmath>
+#include <numeric>
+
+using namespace std;
+
+
+// Wide enough for the resolvent of a quartic within
+// lowDegreeCoefficientLimit, evaluated anywhere its roots can be.
+typedef __int128 Wide;
+
+/**
+ * The resolvent cubic z^3 + c2 z^2 + c1 z + c0.
+ */
+struct Resolvent {
+    Wide c2, c1, c0;
+
+    Wide operator() (Wide z) const {
+        return ((z + c2) * z + c1) * z + c0;
+    }
+};
+
+
+/**
+ * @param n a nonnegative integer
+ * @return the largest integer whose square is at most n
+ */
+static Wide squareRoot(Wide n) {
+    Wide r = (Wide) sqrtl((long double) n);
+    while (r > 0 && r * r > n) {
+        --r;
+    }
+    while ((r + 1) * (r + 1) <= n) {
+        ++r;
+    }
+    return r;
+}
+
+/**
+ * @return true if n is a perfect square, with root set to its
+ *         nonnegative square root
+ */
+static bool isSquare(Wide n, Wide& root) {
+    if (n < 0) {
+        return false;
+    }
+    root = squareRoot(n);
+    return root * root == n;
+}
+
+static Wide floorDivide(Wide n, Wide d) {
+    Wide q = n / d;
+    return (n % d != 0 && (n < 0) != (d < 0)) ? q - 1 : q;
+}
+
+static Polynomial positive(const Polynomial& p) {
+    return (p.getCoeff(p.getDegree()) < 0) ? p * -1 : p;
+}
+
+/**
+ * The primitive polynomial with a positive leading coefficient that is a
+ * rational multiple of c[2] x^2 + c[1] x + c[0].
+ *
+ * @return false if its coefficients do not fit in an int
+ */
+static bool primitiveQuadratic(const long long c[3], Polynomial& q) {
+    long long g = gcd(gcd(c[0], c[1]), c[2]);
+    if (c[2] < 0) {
+        g = -g;
+    }
+    int coeffs[3];
+    for (int i = 0; i < 3; ++i) {
+        long long x = c[i] / g;
+        if (x < INT_MIN || x > INT_MAX) {
+            return false;
+        }
+        coeffs[i] = (int) x;
+    }
+    q = Polynomial(3, coeffs);
+    return true;
+}
+
+/**
+ * Appends the integer roots of g in [low, high], over which g is
+ * strictly monotone, to roots.
+ */
+static void monotoneRoots(const Resolvent& g, Wide low, Wide high, vector<Wide>& roots) {
+    if (low > high) {
+        return;
+    }
+    Wide atLow = g(low), atHigh = g(high);
+    if (atLow == 0 || atHigh == 0) {
+        roots.push_back(atLow == 0 ? low : high);
+        return;
+    }
+    if ((atLow < 0) == (atHigh < 0)) {
+        return;
+    }
+    while (high - low > 1) {
+        Wide middle = low + (high - low) / 2;
+        Wide atMiddle = g(middle);
+        if (atMiddle == 0) {
+            roots.push_back(middle);
+            return;
+        }
+        if ((atMiddle < 0) == (atLow < 0)) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+}
+
+/**
+ * The integer roots of g in [low, high], in increasing order.
+ *
+ * The turning points of g, the roots of 3z^2 + 2 c2 z + c1, are known
+ * only to within an integer or so, so a few integers around each are
+ * tried one by one, and the stretches in between are bisected.
+ */
+static vector<Wide> integerRoots(const Resolvent& g, Wide low, Wide high) {
+    vector<Wide> roots;
+    vector<Wide> turns;
+    Wide discriminant = 4 * g.c2 * g.c2 - 12 * g.c1;
+    if (discriminant > 0) {
+        Wide r = squareRoot(discriminant);
+        turns.push_back(floorDivide(-2 * g.c2 - r, 6));
+        turns.push_back(floorDivide(-2 * g.c2 + r, 6));
+    }
+    Wide start = low;
+    for (Wide k : turns) {
+        monotoneRoots(g, start, min(high, k - 2), roots);
+        for (Wide z = max(start, k - 1); z <= min(high, k + 2); ++z) {
+            if (g(z) == 0) {
+                roots.push_back(z);
+            }
+        }
+        start = max(start, k + 3);
+    }
+    monotoneRoots(g, start, high, roots);
+    return roots;
+}
+
+/**
+ * p = a x^4 + b x^3 + c x^2 + d x + e becomes, with y = 4a x + b and
+ * multiplied by 256 a^3, the monic y^4 + P y^2 + Q y + R. For each
+ * integer root z = s^2 of its resolvent, the coefficients t and u of a
+ * split (y^2 + s y + t)(y^2 - s y + u) follow from t + u = P + s^2 and
+ * s (u - t) = Q, and the split holds if tu = R. With s = 0, which needs
+ * Q = 0, t and u are instead the roots of w^2 - P w + R.
+ *
+ * The roots of y^4 + P y^2 + Q y + R, and so those of the resolvent,
+ * which are the squares of sums of two of them, are bounded in terms of
+ * the largest coefficient m of p: every root is below 400 m^2, and the
+ * resolvent stays well within 128 bits up to there for m below
+ * lowDegreeCoefficientLimit.
+ */
+static bool factorQuartic(const Polynomial& p, vector<Polynomial>& factors) {
+    Wide a = p.getCoeff(4), b = p.getCoeff(3), c = p.getCoeff(2), d = p.getCoeff(1),
+        e = p.getCoeff(0);
+    Wide m = 0;
+    for (int i = 0; i <= 4; ++i) {
+        Wide x = p.getCoeff(i);
+        m = max(m, x < 0 ? -x : x);
+    }
+    if (m >= lowDegreeCoefficientLimit) {
+        return false;
+    }
+    Wide P = 16 * a * c - 6 * b * b;
+    Wide Q = 64 * a * a * d - 32 * a * b * c + 8 * b * b * b;
+    Wide R = 256 * a * a * a * e - 64 * a * a * b * d + 16 * a * b * b * c - 3 * b * b * b * b;
+    Resolvent g = {2 * P, P * P - 4 * R, -Q * Q};
+
+    for (Wide z : integerRoots(g, 0, 400 * m * m)) {
+        Wide s, t, u;
+        if (z == 0) {
+            Wide w;
+            if (!isSquare(P * P - 4 * R, w) || (P + w) % 2 != 0) {
+                continue;
+            }
+            s = 0;
+            t = (P - w) / 2;
+            u = (P + w) / 2;
+        } else {
+            if (!isSquare(z, s) || Q % s != 0 || (P + z - Q / s) % 2 != 0) {
+                continue;
+            }
+            t = (P + z - Q / s) / 2;
+            u = (P + z + Q / s) / 2;
+            if (t * u != R) {
+                continue;
+            }
+        }
+        // y^2 + s y + t with y = 4a x + b
+        long long quadratic[3] = {(long long) (b * b + s * b + t), (long long) (8 * a * b + 4 * a * s),
+                                  (long long) (16 * a * a)};
+        Polynomial f, cofactor;
+        if (primitiveQuadratic(quadratic, f) && (cofactor = p / f).getDegree() == 2) {
+            factors.push_back(f);
+            factors.push_back(positive(cofactor));
+            return true;
+        }
+    }
+    factors.push_back(positive(p));
+    return true;
+}
+
+/**
+ * With discriminant b^2 - 4ac = s^2, a x^2 + b x + c has the roots
+ * (-b + s) / 2a and (-b - s) / 2a, and so the factors 2a x + b - s and
+ * 2a x + b + s, up to constants.
+ */
+static void factorQuadratic(const Polynomial& p, vector<Polynomial>& factors) {
+    long long a = p.getCoeff(2), b = p.getCoeff(1), c = p.getCoeff(0);
+    Wide s;
+    if (!isSquare((Wide) b * b - (Wide) 4 * a * c, s)) {
+        factors.push_back(positive(p));
+        return;
+    }
+    for (long long constant : {b - (long long) s, b + (long long) s}) {
+        long long g = gcd(2 * a, constant);
+        if (a < 0) {
+            g = -g;
+        }
+        factors.push_back(Polynomial((int) (constant / g), (int) (2 * a / g)));
+    }
+}
+
+bool factorLowDegree(const Polynomial& p, vector<Polynomial>& factors) {
+    switch (p.getDegree()) {
+    case 2:
+        factorQuadratic(p, factors);
+        return true;
+    case 4:
+        return factorQuartic(p, factors);
+    default:
+        factors.push_back(positive(p));
+        return true;
+    }
+}
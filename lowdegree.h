@@ -0,0 +1,43 @@
+#ifndef LOWDEGREE_H
+#define LOWDEGREE_H
+
+#include <vector>
+#include "polynomial.h"
+
+/**
+ * Factorization of integer polynomials of degree 2 to 4 in closed form,
+ * with no modular factoring:
+ *
+ *  - a quadratic splits if and only if its discriminant is a perfect
+ *    square, which an exact integer square root decides;
+ *  - a cubic with no rational root is irreducible;
+ *  - a quartic with no rational root either is irreducible or splits
+ *    into two quadratics. It is shifted and scaled to a monic quartic
+ *    y^4 + P y^2 + Q y + R, whose factors
+ *    (y^2 + s y + t)(y^2 - s y + u) over the rationals have integer
+ *    coefficients, and s^2 is then an integer root of the resolvent cubic
+ *    z^3 + 2P z^2 + (P^2 - 4R) z - Q^2. The resolvent is monotone
+ *    between its turning points, so its integer roots are found exactly,
+ *    by bisection.
+ */
+
+/**
+ * A quartic's coefficients must all be smaller than this in absolute
+ * value for its resolvent to be evaluated exactly in 128 bits.
+ */
+const int lowDegreeCoefficientLimit = 1 << 16;
+
+/**
+ * Factor a polynomial of degree 2, 3 or 4 over the integers.
+ *
+ * @param p a primitive polynomial of degree 2, 3 or 4; one of degree 3
+ *          or 4 must have no rational roots
+ * @param factors output: the irreducible factors of p, each primitive
+ *                with a positive leading coefficient, repeated according
+ *                to multiplicity
+ * @return false, leaving factors as it was, if p is a quartic with a
+ *         coefficient too large for the closed form
+ */
+bool factorLowDegree(const Polynomial& p, std::vector<Polynomial>& factors);
+
+#endif
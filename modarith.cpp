@@ -0,0 +1,47 @@
+#include "modarith.h"
+
+Residue ProductSum::reduce(Residue m) const
+{
+    Residue sum = (Residue)(low % m);
+    if (wraps != 0)
+    {
+        Residue wrap = mulMod((Residue)(((unsigned __int128)1 << 64) % m),
+                              (Residue)(((unsigned __int128)1 << 64) % m), m);
+        sum = addMod(sum, mulMod(wraps % m, wrap, m), m);
+    }
+    return sum;
+}
+
+Residue powMod(Residue base, unsigned long long exponent, Residue m)
+{
+    Residue result = 1 % m;
+    base %= m;
+    while (exponent > 0)
+    {
+        if (exponent & 1)
+            result = mulMod(result, base, m);
+        base = mulMod(base, base, m);
+        exponent >>= 1;
+    }
+    return result;
+}
+
+Residue invMod(Residue x, Residue m)
+{
+    // Extended Euclid, tracking only the coefficient of x.
+    long long t = 0, newT = 1;
+    Residue r = m, newR = x % m;
+    while (newR != 0)
+    {
+        Residue q = r / newR;
+        long long nextT = t - (long long)q * newT;
+        t = newT;
+        newT = nextT;
+        Residue nextR = r - q * newR;
+        r = newR;
+        newR = nextR;
+    }
+    if (r != 1)
+        return 0;
+    return (t < 0) ? (Residue)t + m : (Residue)t;
+}
@@ -0,0 +1,70 @@
+#ifndef MODARITH_H
+#define MODARITH_H
+
+/**
+ * Arithmetic on residues modulo a word-sized modulus m, 1 < m < 2^63.
+ * All residues are kept in the range [0, m).
+ */
+typedef unsigned long long Residue;
+
+inline Residue addMod(Residue x, Residue y, Residue m)
+{
+    Residue sum = x + y;
+    return (sum >= m) ? sum - m : sum;
+}
+
+inline Residue subMod(Residue x, Residue y, Residue m)
+{
+    return (x >= y) ? x - y : x + (m - y);
+}
+
+inline Residue mulMod(Residue x, Residue y, Residue m)
+{
+    return (Residue)((unsigned __int128)x * y % m);
+}
+
+inline Residue toResidue(long long x, Residue m)
+{
+    long long r = x % (long long)m;
+    return (r < 0) ? (Residue)r + m : (Residue)r;
+}
+
+/**
+ * The symmetric representative of a residue, in (-m/2, m/2].
+ */
+inline long long fromResidue(Residue x, Residue m)
+{
+    return (x > m / 2) ? -(long long)(m - x) : (long long)x;
+}
+
+/**
+ * A sum of products of residues, accumulated exactly in 128 bits and
+ * reduced modulo m only once, when it is read, rather than after every
+ * term. Each product is below 2^126, so the sum wraps at most once per
+ * term added; the wraps are counted and folded back in by reduce().
+ */
+struct ProductSum
+{
+    unsigned __int128 low = 0;
+    unsigned long long wraps = 0;
+
+    void add(Residue x, Residue y)
+    {
+        unsigned __int128 product = (unsigned __int128)x * y;
+        low += product;
+        wraps += (low < product);
+    }
+
+    Residue reduce(Residue m) const;
+};
+
+Residue powMod(Residue base, unsigned long long exponent, Residue m);
+
+/**
+ * Multiplicative inverse of x modulo m.
+ *
+ * @return the inverse, or 0 if x is not invertible modulo m
+ */
+Residue invMod(Residue x, Residue m);
+
+#endif
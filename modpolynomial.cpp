@@ -0,0 +1,461 @@
+#include "modpolynomial.h"
+#include <algorithm>
+
+using namespace std;
+
+
+/**
+ * Schoolbook product, one coefficient at a time, so that each is reduced
+ * modulo m once rather than after every multiply-add.
+ */
+static void multiplySchoolbook(const Residue* a, size_t na, const Residue* b, size_t nb,
+                               Residue* product, Residue m) {
+    for (size_t k = 0; k + 1 < na + nb; ++k) {
+        ProductSum sum;
+        size_t first = (k >= nb) ? k - nb + 1 : 0;
+        size_t last = min(k, na - 1);
+        for (size_t i = first; i <= last; ++i) {
+            sum.add(a[i], b[k - i]);
+        }
+        product[k] = sum.reduce(m);
+    }
+}
+
+/**
+ * Karatsuba product of two length-n coefficient arrays into the 2n-1
+ * entries of product.
+ */
+static void multiplyKaratsuba(const Residue* a, const Residue* b, size_t n,
+                              Residue* product, Residue m) {
+    if (n < (size_t) ModPolynomial::karatsubaThreshold) {
+        multiplySchoolbook(a, n, b, n, product, m);
+        return;
+    }
+
+    // a = a0 + x^h a1, with a0 of length h and a1 of length hh >= h
+    size_t h = n / 2;
+    size_t hh = n - h;
+    vector<Residue> low(2 * h - 1), high(2 * hh - 1), middle(2 * hh - 1);
+    multiplyKaratsuba(a, b, h, low.data(), m);
+    multiplyKaratsuba(a + h, b + h, hh, high.data(), m);
+
+    vector<Residue> aSum(a + h, a + n), bSum(b + h, b + n);
+    for (size_t i = 0; i < h; ++i) {
+        aSum[i] = addMod(aSum[i], a[i], m);
+        bSum[i] = addMod(bSum[i], b[i], m);
+    }
+    multiplyKaratsuba(aSum.data(), bSum.data(), hh, middle.data(), m);
+    for (size_t i = 0; i < low.size(); ++i) {
+        middle[i] = subMod(middle[i], low[i], m);
+    }
+    for (size_t i = 0; i < high.size(); ++i) {
+        middle[i] = subMod(middle[i], high[i], m);
+    }
+
+    fill(product, product + 2 * n - 1, 0);
+    for (size_t i = 0; i < low.size(); ++i) {
+        product[i] = low[i];
+    }
+    for (size_t i = 0; i < high.size(); ++i) {
+        product[2 * h + i] = high[i];
+    }
+    for (size_t i = 0; i < middle.size(); ++i) {
+        product[h + i] = addMod(product[h + i], middle[i], m);
+    }
+}
+
+static vector<Residue> multiply(const vector<Residue>& a, const vector<Residue>& b, Residue m) {
+    if (a.empty() || b.empty()) {
+        return vector<Residue>();
+    }
+    const vector<Residue>& longer = (a.size() >= b.size()) ? a : b;
+    const vector<Residue>& shorter = (a.size() >= b.size()) ? b : a;
+    size_t n = shorter.size();
+    vector<Residue> product(a.size() + b.size() - 1, 0);
+    if (n < (size_t) ModPolynomial::karatsubaThreshold) {
+        multiplySchoolbook(longer.data(), longer.size(), shorter.data(), n, product.data(), m);
+        return product;
+    }
+
+    // Unbalanced operands are cut into blocks the size of the shorter one.
+    vector<Residue> block(n), blockProduct(2 * n - 1);
+    for (size_t start = 0; start < longer.size(); start += n) {
+        size_t len = min(n, longer.size() - start);
+        copy(longer.begin() + start, longer.begin() + start + len, block.begin());
+        fill(block.begin() + len, block.end(), 0);
+        multiplyKaratsuba(block.data(), shorter.data(), n, blockProduct.data(), m);
+        for (size_t i = 0; i < blockProduct.size() && start + i < product.size(); ++i) {
+            product[start + i] = addMod(product[start + i], blockProduct[i], m);
+        }
+    }
+    return product;
+}
+
+/**
+ * Power series inverse of f modulo x^len by Newton iteration,
+ * g <- g (2 - f g), doubling the precision each step.
+ */
+static vector<Residue> inverseSeries(const vector<Residue>& f, size_t len, Residue m) {
+    vector<Residue> g(1, invMod(f[0], m));
+    size_t precision = 1;
+    while (precision < len) {
+        precision = min(2 * precision, len);
+        vector<Residue> fLow(f.begin(), f.begin() + min(precision, f.size()));
+        vector<Residue> fg = multiply(fLow, g, m);
+        fg.resize(precision, 0);
+        for (Residue& c : fg) {
+            c = subMod(0, c, m);
+        }
+        fg[0] = addMod(fg[0], 2 % m, m);
+        g = multiply(g, fg, m);
+        g.resize(precision, 0);
+    }
+    return g;
+}
+
+
+ModPolynomial::ModPolynomial(Residue modulus) : modulus(modulus) {
+}
+
+ModPolynomial::ModPolynomial(Residue modulus, vector<Residue> coefficients)
+    : modulus(modulus), coeffs(std::move(coefficients)) {
+    for (Residue& c : coeffs) {
+        c %= modulus;
+    }
+    normalize();
+}
+
+ModPolynomial::ModPolynomial(const Polynomial& p, Residue modulus) : modulus(modulus) {
+    if (p.getDegree() < 0) {
+        return;
+    }
+    coeffs.assign(p.getDegree() + 1, 0);
+    for (const Term& term : p) {
+        coeffs[term.power] = addMod(coeffs[term.power], toResidue(term.coefficient, modulus), modulus);
+    }
+    normalize();
+}
+
+Residue ModPolynomial::getModulus() const {
+    return modulus;
+}
+
+int ModPolynomial::getDegree() const {
+    return coeffs.empty() ? 0 : (int) coeffs.size() - 1;
+}
+
+Residue ModPolynomial::getCoeff(int power) const {
+    if (power >= 0 && power < (int) coeffs.size()) {
+        return coeffs[power];
+    } else {
+        return 0;
+    }
+}
+
+bool ModPolynomial::isZero() const {
+    return coeffs.empty();
+}
+
+ModPolynomial ModPolynomial::operator+ (const ModPolynomial& p) const {
+    vector<Residue> result(max(coeffs.size(), p.coeffs.size()), 0);
+    for (size_t i = 0; i < result.size(); ++i) {
+        result[i] = addMod(getCoeff(i), p.getCoeff(i), modulus);
+    }
+    return ModPolynomial(modulus, result);
+}
+
+ModPolynomial ModPolynomial::operator- (const ModPolynomial& p) const {
+    vector<Residue> result(max(coeffs.size(), p.coeffs.size()), 0);
+    for (size_t i = 0; i < result.size(); ++i) {
+        result[i] = subMod(getCoeff(i), p.getCoeff(i), modulus);
+    }
+    return ModPolynomial(modulus, result);
+}
+
+ModPolynomial ModPolynomial::operator* (const ModPolynomial& p) const {
+    return ModPolynomial(modulus, multiply(coeffs, p.coeffs, modulus));
+}
+
+ModPolynomial ModPolynomial::operator/ (const ModPolynomial& denominator) const {
+    ModPolynomial quotient(modulus), remainder(modulus);
+    divide(denominator, quotient, remainder);
+    return quotient;
+}
+
+ModPolynomial ModPolynomial::operator% (const ModPolynomial& denominator) const {
+    ModPolynomial quotient(modulus), remainder(modulus);
+    divide(denominator, quotient, remainder);
+    return remainder;
+}
+
+/**
+ * Division with remainder, *this == quotient * denominator + remainder
+ * with deg remainder < deg denominator.
+ *
+ * Large divisions reverse both operands and multiply by a Newton inverse
+ * of the reversed denominator, so they cost a few multiplications rather
+ * than (deg quotient) * (deg denominator) multiply-adds.
+ *
+ * @param denominator a nonzero polynomial with the same modulus
+ * @param quotient output: the quotient
+ * @param remainder output: the remainder
+ */
+void ModPolynomial::divide(const ModPolynomial& denominator,
+                           ModPolynomial& quotient, ModPolynomial& remainder) const {
+    if (coeffs.size() < denominator.coeffs.size()) {
+        remainder = *this;
+        quotient = ModPolynomial(modulus);
+        return;
+    }
+
+    size_t d = denominator.coeffs.size() - 1;
+    size_t qLen = coeffs.size() - d;
+    if (d < (size_t) newtonThreshold || qLen < (size_t) newtonThreshold) {
+        vector<Residue> r = coeffs;
+        vector<Residue> q(qLen, 0);
+        Residue leadInverse = invMod(denominator.coeffs[d], modulus);
+        for (size_t i = qLen; i-- > 0;) {
+            Residue c = mulMod(r[i + d], leadInverse, modulus);
+            q[i] = c;
+            if (c == 0) {
+                continue;
+            }
+            for (size_t j = 0; j <= d; ++j) {
+                r[i + j] = subMod(r[i + j], mulMod(c, denominator.coeffs[j], modulus), modulus);
+            }
+        }
+        r.resize(d);
+        quotient = ModPolynomial(modulus, q);
+        remainder = ModPolynomial(modulus, r);
+        return;
+    }
+
+    vector<Residue> reversedNumerator(coeffs.rbegin(), coeffs.rbegin() + qLen);
+    vector<Residue> reversedDenominator(denominator.coeffs.rbegin(), denominator.coeffs.rend());
+    vector<Residue> q = multiply(reversedNumerator,
+                                 inverseSeries(reversedDenominator, qLen, modulus), modulus);
+    q.resize(qLen, 0);
+    reverse(q.begin(), q.end());
+    ModPolynomial q0(modulus, q);
+    remainder = *this - q0 * denominator;
+    quotient = q0;
+}
+
+bool ModPolynomial::operator== (const ModPolynomial& p) const {
+    return modulus == p.modulus && coeffs == p.coeffs;
+}
+
+Residue ModPolynomial::evaluate(Residue x) const {
+    Residue result = 0;
+    for (size_t i = coeffs.size(); i-- > 0;) {
+        result = addMod(mulMod(result, x, modulus), coeffs[i], modulus);
+    }
+    return result;
+}
+
+/**
+ * Evaluate at many points at once via a subproduct tree.
+ *
+ * The leaves of the tree are the linear polynomials x - xs[i] and each
+ * inner node is the product of its children. Reducing this polynomial
+ * modulo the root and then each remainder modulo the children carries it
+ * down to the leaves, where the remainder modulo x - xs[i] is the value
+ * at xs[i]. With fast multiplication and division this takes
+ * O(M(n) log n) operations for n points and degree n, against n^2 for
+ * separate Horner evaluations.
+ *
+ * @param xs the points, as residues
+ * @return the values at each of xs, in the same order
+ */
+vector<Residue> ModPolynomial::evaluate(const vector<Residue>& xs) const {
+    vector<Residue> values(xs.size(), 0);
+    if (xs.empty()) {
+        return values;
+    }
+
+    vector<vector<ModPolynomial>> tree(1);
+    for (Residue x : xs) {
+        tree[0].push_back(ModPolynomial(modulus, {subMod(0, x % modulus, modulus), 1}));
+    }
+    while (tree.back().size() > 1) {
+        const vector<ModPolynomial>& below = tree.back();
+        vector<ModPolynomial> level;
+        for (size_t i = 0; i + 1 < below.size(); i += 2) {
+            level.push_back(below[i] * below[i + 1]);
+        }
+        if (below.size() % 2 == 1) {
+            level.push_back(below.back());
+        }
+        tree.push_back(level);
+    }
+
+    // Node j of a level is the parent of nodes 2j and 2j+1 of the level
+    // below. The last level of division (by the leaves themselves) is
+    // replaced by evaluating the two-point remainders directly.
+    vector<ModPolynomial> remainders(1, *this % tree.back()[0]);
+    for (size_t level = tree.size() - 1; level > 1; --level) {
+        const vector<ModPolynomial>& children = tree[level - 1];
+        vector<ModPolynomial> next;
+        for (size_t j = 0; j < children.size(); ++j) {
+            next.push_back(remainders[j / 2] % children[j]);
+        }
+        remainders.swap(next);
+    }
+    for (size_t i = 0; i < xs.size(); ++i) {
+        values[i] = remainders[i / 2].evaluate(xs[i] % modulus);
+    }
+    return values;
+}
+
+ModPolynomial ModPolynomial::derivative() const {
+    vector<Residue> result;
+    for (size_t i = 1; i < coeffs.size(); ++i) {
+        result.push_back(mulMod(coeffs[i], i % modulus, modulus));
+    }
+    return ModPolynomial(modulus, result);
+}
+
+/**
+ * This polynomial divided by its leading coefficient, which must be
+ * invertible; the zero polynomial is returned unchanged.
+ */
+ModPolynomial ModPolynomial::monic() const {
+    if (coeffs.empty()) {
+        return *this;
+    }
+    Residue leadInverse = invMod(coeffs.back(), modulus);
+    vector<Residue> result(coeffs.size());
+    for (size_t i = 0; i < coeffs.size(); ++i) {
+        result[i] = mulMod(coeffs[i], leadInverse, modulus);
+    }
+    return ModPolynomial(modulus, result);
+}
+
+/**
+ * This polynomial raised to a power modulo f, by repeated squaring.
+ *
+ * @param exponent the power
+ * @param f a nonzero polynomial with the same modulus
+ * @return this^exponent mod f
+ */
+ModPolynomial ModPolynomial::powMod(unsigned long long exponent, const ModPolynomial& f) const {
+    ModPolynomial result = ModPolynomial(modulus, vector<Residue>{1}) % f;
+    ModPolynomial base = *this % f;
+    while (exponent > 0) {
+        if (exponent & 1) {
+            result = (result * base) % f;
+        }
+        exponent >>= 1;
+        if (exponent > 0) {
+            base = (base * base) % f;
+        }
+    }
+    return result;
+}
+
+/**
+ * Split a product of distinct monic linear factors into its roots by
+ * Cantor-Zassenhaus equal-degree splitting: for a shift d, the roots r
+ * with (r + d)^((m-1)/2) == 1 are separated from the rest by
+ * gcd((x + d)^((m-1)/2) - 1, g). The shifts are tried in the order
+ * 0, 1, 2, ... so the results are reproducible.
+ */
+static void splitRoots(const ModPolynomial& g, vector<Residue>& roots) {
+    Residue m = g.getModulus();
+    if (g.getDegree() == 0) {
+        return;
+    }
+    if (g.getDegree() == 1) {
+        roots.push_back(subMod(0, mulMod(g.getCoeff(0), invMod(g.getCoeff(1), m), m), m));
+        return;
+    }
+    for (Residue shift = 0; ; ++shift) {
+        ModPolynomial h = ModPolynomial(m, {shift, 1}).powMod((m - 1) / 2, g)
+            - ModPolynomial(m, vector<Residue>{1});
+        ModPolynomial d = gcd(g, h);
+        if (d.getDegree() > 0 && d.getDegree() < g.getDegree()) {
+            splitRoots(d, roots);
+            splitRoots(g / d, roots);
+            return;
+        }
+    }
+}
+
+/**
+ * The distinct roots of this polynomial in the integers modulo its
+ * modulus, which must be prime.
+ *
+ * The roots are those of gcd(x^m - x, p), the product of the distinct
+ * linear factors of p, which is then split by equal-degree
+ * factorization. Only the computation of x^m mod p depends on the size
+ * of the modulus, through the log m squarings it takes.
+ *
+ * @return the roots in increasing order; empty for the zero polynomial
+ */
+vector<Residue> ModPolynomial::roots() const {
+    vector<Residue> result;
+    if (coeffs.empty()) {
+        return result;
+    }
+    if (modulus == 2) {
+        for (Residue r = 0; r < 2; ++r) {
+            if (evaluate(r) == 0) {
+                result.push_back(r);
+            }
+        }
+        return result;
+    }
+    ModPolynomial f = monic();
+    ModPolynomial x(modulus, {0, 1});
+    ModPolynomial linear = gcd(f, x.powMod(modulus, f) - x);
+    splitRoots(linear, result);
+    sort(result.begin(), result.end());
+    return result;
+}
+
+void ModPolynomial::normalize() {
+    while (!coeffs.empty() && coeffs.back() == 0) {
+        coeffs.pop_back();
+    }
+}
+
+ostream& operator<< (ostream& out, const ModPolynomial& p) {
+    if (p.coeffs.empty()) {
+        out << 0;
+    }
+    bool first = true;
+    for (size_t i = p.coeffs.size(); i-- > 0;) {
+        if (p.coeffs[i] == 0) {
+            continue;
+        }
+        if (!first) {
+            out << " + ";
+        }
+        first = false;
+        if (p.coeffs[i] != 1 || i == 0) {
+            out << p.coeffs[i];
+        }
+        if (i > 0) {
+            out << "x";
+            if (i > 1) {
+                out << "^" << i;
+            }
+        }
+    }
+    out << " (mod " << p.modulus << ")";
+    return out;
+}
+
+/**
+ * The monic greatest common divisor of two polynomials over the same
+ * prime modulus, by Euclid's algorithm; the gcd of two zero polynomials
+ * is zero.
+ */
+ModPolynomial gcd(ModPolynomial p, ModPolynomial q) {
+    while (!q.isZero()) {
+        ModPolynomial r = p % q;
+        p = q;
+        q = r;
+    }
+    return p.monic();
+}
@@ -0,0 +1,64 @@
+#ifndef MODPOLYNOMIAL_H
+#define MODPOLYNOMIAL_H
+
+#include <iostream>
+#include <vector>
+#include "modarith.h"
+#include "polynomial.h"
+
+/**
+ * A dense polynomial with coefficients reduced modulo a word-sized
+ * prime, used by the evaluation and factoring code for arithmetic that
+ * would overflow over the integers.
+ *
+ * Coefficients are stored lowest power first with no trailing zeros, so
+ * the zero polynomial has no coefficients (and, as with Polynomial, is
+ * reported as having degree 0).
+ */
+class ModPolynomial {
+public:
+    explicit ModPolynomial(Residue modulus);
+    ModPolynomial(Residue modulus, std::vector<Residue> coefficients);
+    ModPolynomial(const Polynomial& p, Residue modulus);
+
+    Residue getModulus() const;
+    int getDegree() const;
+    Residue getCoeff(int power) const;
+    bool isZero() const;
+
+    ModPolynomial operator+ (const ModPolynomial& p) const;
+    ModPolynomial operator- (const ModPolynomial& p) const;
+    ModPolynomial operator* (const ModPolynomial& p) const;
+    ModPolynomial operator/ (const ModPolynomial& denominator) const;
+    ModPolynomial operator% (const ModPolynomial& denominator) const;
+    void divide(const ModPolynomial& denominator,
+                ModPolynomial& quotient, ModPolynomial& remainder) const;
+    bool operator== (const ModPolynomial& p) const;
+
+    Residue evaluate(Residue x) const;
+    std::vector<Residue> evaluate(const std::vector<Residue>& xs) const;
+
+    ModPolynomial derivative() const;
+    ModPolynomial monic() const;
+    ModPolynomial powMod(unsigned long long exponent, const ModPolynomial& f) const;
+    std::vector<Residue> roots() const;
+
+    static const int karatsubaThreshold = 32;
+    static const int newtonThreshold = 64;
+
+private:
+    Residue modulus;
+    std::vector<Residue> coeffs;
+    void normalize();
+    friend std::ostream& operator<< (std::ostream&, const ModPolynomial&);
+};
+
+std::ostream& operator<< (std::ostream&, const ModPolynomial&);
+
+ModPolynomial gcd(ModPolynomial p, ModPolynomial q);
+
+inline bool operator!= (const ModPolynomial& p, const ModPolynomial& q) {
+    return !(p == q);
+}
+
+#endif
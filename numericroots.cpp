@@ -0,0 +1,161 @@
+#include "numericroots.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <tuple>
+
+using namespace std;
+
+
+// The iteration stops once every correction is below this many ulps of
+// its root, or after maxIterations sweeps (multiple roots converge only
+// linearly and are left wherever they have got to).
+static const double convergenceUlps = 4.0;
+static const int maxIterations = 200;
+
+// Approximations whose imaginary part is at most this fraction of their
+// magnitude are treated as real. It is loose enough to admit the
+// scattered approximations of a repeated root.
+static const double realTolerance = 1e-4;
+
+
+/**
+ * The Newton correction p(z)/p'(z). Outside the unit circle it is
+ * computed from the reversed polynomial at 1/z, so that no power of z
+ * larger than 1 in magnitude is ever formed.
+ *
+ * @param c the coefficients of p, lowest power first
+ * @param z the point
+ */
+static complex<double> newtonCorrection(const vector<double>& c, complex<double> z) {
+    int n = c.size() - 1;
+    complex<double> value, slope;
+    if (abs(z) <= 1.0) {
+        value = c[n];
+        for (int i = n - 1; i >= 0; --i) {
+            slope = slope * z + value;
+            value = value * z + c[i];
+        }
+        return (value == 0.0) ? value : value / slope;
+    }
+    // p(z) = z^n r(w) with r(w) = c[0] w^n + ... + c[n] and w = 1/z, so
+    // p(z)/p'(z) = z r(w) / (n r(w) - w r'(w)).
+    complex<double> w = 1.0 / z;
+    value = c[0];
+    for (int i = 1; i <= n; ++i) {
+        slope = slope * w + value;
+        value = value * w + c[i];
+    }
+    return (value == 0.0) ? value : z * value / ((double) n * value - w * slope);
+}
+
+
+vector<complex<double>> approximateRoots(const Polynomial& p) {
+    int n = p.getDegree();
+    if (n < 1 || n > maxApproximatedDegree) {
+        return vector<complex<double>>();
+    }
+    vector<double> c(n + 1, 0.0);
+    for (const Term& term : p) {
+        c[term.power] += term.coefficient;
+    }
+
+    // Start evenly spaced, off the real axis, on the circle whose radius
+    // is the geometric mean of the roots' magnitudes.
+    int lowest = 0;
+    while (c[lowest] == 0.0) {
+        ++lowest;
+    }
+    double radius = (lowest == n) ? 1.0 : pow(fabs(c[lowest] / c[n]), 1.0 / (n - lowest));
+    const double pi = acos(-1.0);
+    vector<double> re(n), im(n);
+    for (int k = 0; k < n; ++k) {
+        double angle = 2 * pi * k / n + pi / (2 * n);
+        re[k] = radius * cos(angle);
+        im[k] = radius * sin(angle);
+    }
+
+    // Jacobi-style sweeps: every correction is computed from the previous
+    // sweep's approximations, so the sums over the other roots are
+    // independent across i and run over plain arrays of reals.
+    vector<double> stepRe(n), stepIm(n);
+    for (int iteration = 0; iteration < maxIterations; ++iteration) {
+        bool converged = true;
+        for (int i = 0; i < n; ++i) {
+            complex<double> z(re[i], im[i]);
+            complex<double> newton = newtonCorrection(c, z);
+            double sumRe = 0.0, sumIm = 0.0;
+            for (int j = 0; j < i; ++j) {
+                double dr = re[i] - re[j], di = im[i] - im[j];
+                double q = dr * dr + di * di;
+                sumRe += dr / q;
+                sumIm -= di / q;
+            }
+            for (int j = i + 1; j < n; ++j) {
+                double dr = re[i] - re[j], di = im[i] - im[j];
+                double q = dr * dr + di * di;
+                sumRe += dr / q;
+                sumIm -= di / q;
+            }
+            complex<double> step = newton / (1.0 - newton * complex<double>(sumRe, sumIm));
+            if (!isfinite(step.real()) || !isfinite(step.imag())) {
+                step = 0.0;
+            }
+            stepRe[i] = step.real();
+            stepIm[i] = step.imag();
+            if (abs(step) > convergenceUlps * numeric_limits<double>::epsilon() * abs(z)) {
+                converged = false;
+            }
+        }
+        for (int i = 0; i < n; ++i) {
+            re[i] -= stepRe[i];
+            im[i] -= stepIm[i];
+        }
+        if (converged) {
+            break;
+        }
+    }
+
+    vector<complex<double>> roots(n);
+    for (int i = 0; i < n; ++i) {
+        roots[i] = complex<double>(re[i], im[i]);
+    }
+    return roots;
+}
+
+
+vector<pair<int,int>> nearbyRationals(const vector<complex<double>>& roots,
+                                      const vector<unsigned long long>& denominators,
+                                      const vector<unsigned long long>& numerators) {
+    const double largest = numeric_limits<int>::max();
+    vector<pair<int,int>> result;
+    for (const complex<double>& z : roots) {
+        if (fabs(z.imag()) > realTolerance * max(1.0, abs(z))) {
+            continue;
+        }
+        double x = z.real();
+        for (unsigned long long a : denominators) {
+            double t = fabs(x) * a;
+            if (t >= largest) {
+                break;
+            }
+            // Both neighbours of |x| a, so that a slightly inaccurate
+            // approximation still rounds to the right numerator.
+            for (double b : {floor(t), ceil(t)}) {
+                unsigned long long numerator = (unsigned long long) b;
+                if (numerator == 0 || gcd(numerator, a) != 1
+                    || !binary_search(numerators.begin(), numerators.end(), numerator)) {
+                    continue;
+                }
+                result.emplace_back((int) numerator, (x < 0) ? (int) a : -(int) a);
+            }
+        }
+    }
+    sort(result.begin(), result.end(), [](const pair<int,int>& f, const pair<int,int>& g) {
+        return make_tuple(abs(f.second), f.first, f.second < 0)
+            < make_tuple(abs(g.second), g.first, g.second < 0);
+    });
+    result.erase(unique(result.begin(), result.end()), result.end());
+    return result;
+}
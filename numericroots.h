@@ -0,0 +1,51 @@
+#ifndef NUMERICROOTS_H
+#define NUMERICROOTS_H
+
+#include <complex>
+#include <utility>
+#include <vector>
+#include "polynomial.h"
+
+/**
+ * Floating-point approximation of the roots of a polynomial, used to
+ * guess which candidate linear factors are worth testing first.
+ *
+ * Nothing here is exact: a proposed factor still has to be verified by
+ * exact evaluation and division, and a root the approximations miss is
+ * still found by the exhaustive search over divisors.
+ */
+
+/**
+ * Polynomials above this degree are not approximated; each iteration
+ * costs time quadratic in the degree.
+ */
+const int maxApproximatedDegree = 1000;
+
+/**
+ * Approximate all the complex roots of p simultaneously by the
+ * Aberth-Ehrlich iteration in double precision.
+ *
+ * @param p a polynomial of degree at most maxApproximatedDegree
+ * @return deg p approximations, repeated roots appearing once per
+ *         multiplicity; empty if p has degree < 1 or is too large
+ */
+std::vector<std::complex<double>> approximateRoots(const Polynomial& p);
+
+/**
+ * Candidate linear factors whose roots lie close to real approximations.
+ *
+ * For each approximation x with negligible imaginary part and each
+ * denominator a, the integers b next to |x| a that are among the allowed
+ * numerators and prime to a give the factor with root -b/a or b/a.
+ *
+ * @param roots approximate roots
+ * @param denominators allowed values of a, in increasing order
+ * @param numerators allowed values of b, in increasing order
+ * @return (b, a) pairs denoting factors ax + b, in the order the
+ *         exhaustive search would reach them, without repeats
+ */
+std::vector<std::pair<int,int>> nearbyRationals(const std::vector<std::complex<double>>& roots,
+                                                const std::vector<unsigned long long>& denominators,
+                                                const std::vector<unsigned long long>& numerators);
+
+#endif
@@ -0,0 +1,129 @@
+#include "padicroots.h"
+#include "divisors.h"
+#include "modarith.h"
+#include "modpolynomial.h"
+#include <algorithm>
+#include <climits>
+#include <numeric>
+#include <tuple>
+
+using namespace std;
+
+
+// Lifted roots are kept modulo a power of the prime below this, so
+// that modarith's sums of residues cannot overflow.
+static const long double liftLimit = 1ULL << 62;
+
+
+/**
+ * Lift a simple root r of g modulo q to a root modulo q^e = m by Newton's
+ * iteration, which doubles the number of correct q-adic digits each step.
+ *
+ * @param g the polynomial, with coefficients reduced modulo m
+ * @param r a root of g modulo q at which g' is nonzero modulo q
+ * @param e the exponent of the target modulus
+ * @return the root of g modulo m congruent to r modulo q
+ */
+static Residue liftRoot(const ModPolynomial& g, Residue r, int e) {
+    Residue m = g.getModulus();
+    ModPolynomial slope = g.derivative();
+    for (int precision = 1; precision < e; precision *= 2) {
+        Residue correction = mulMod(g.evaluate(r), invMod(slope.evaluate(r), m), m);
+        r = subMod(r, correction, m);
+    }
+    return r;
+}
+
+
+bool padicRootCandidates(const Polynomial& p, vector<pair<int,int>>& candidates) {
+    candidates.clear();
+    int n = p.getDegree();
+    if (p == Polynomial()) {
+        return false;
+    }
+    if (n < 1) {
+        return true;
+    }
+    long long lead = p.getCoeff(n);
+    long long constant = p.getCoeff(0);
+
+    // lead * r is an integer for every rational root r, and is smaller in
+    // magnitude than half of any modulus above this.
+    long double positive, negative;
+    p.rootBounds(positive, negative);
+    long double needed = 2 * llabs(lead) * (max(positive, negative) * (1 + 1e-9L) + 1) + 1;
+    if (needed * padicPrimeLimit >= liftLimit) {
+        return false;
+    }
+
+    // Prefer a prime modulo which every root is simple; failing that,
+    // settle for the first one tried.
+    Residue q = 0;
+    vector<Residue> roots;
+    bool complete = false;
+    int tried = 0;
+    for (Residue prime = padicPrimeLimit - 1; prime > (Residue) n && tried < padicPrimeTrials; --prime) {
+        if (!isPrime(prime) || toResidue(lead, prime) == 0) {
+            continue;
+        }
+        ++tried;
+        ModPolynomial reduced(p, prime);
+        vector<Residue> primeRoots = reduced.roots();
+        ModPolynomial slope = reduced.derivative();
+        bool simple = all_of(primeRoots.begin(), primeRoots.end(),
+                             [&](Residue r) { return slope.evaluate(r) != 0; });
+        if (simple || q == 0) {
+            q = prime;
+            roots = primeRoots;
+            complete = simple;
+        }
+        if (simple) {
+            break;
+        }
+    }
+    if (q == 0) {
+        return false;
+    }
+
+    int e = 1;
+    Residue m = q;
+    while (m < needed) {
+        m *= q;
+        ++e;
+    }
+    ModPolynomial reduced(p, q);
+    ModPolynomial lifted(p, m);
+    for (Residue r : roots) {
+        // The lowest derivative that is nonzero at r modulo q; it exists
+        // because q > n and q does not divide the lead coefficient.
+        ModPolynomial g = lifted;
+        ModPolynomial slope = reduced.derivative();
+        while (slope.evaluate(r) == 0) {
+            g = g.derivative();
+            slope = slope.derivative();
+        }
+        Residue root = liftRoot(g, r, e);
+
+        long long z = fromResidue(mulMod(toResidue(lead, m), root, m), m);
+        long long d = gcd(z, lead);
+        long long b = -z / d, a = lead / d;
+        if (b < 0 || (b == 0 && a < 0)) {
+            b = -b;
+            a = -a;
+        }
+        // A root modulo q need not come from a rational root at all; the
+        // numerator of a rational root must divide the constant term.
+        if (b > INT_MAX || a > INT_MAX || a < -INT_MAX
+            || (constant != 0 && (b == 0 || constant % b != 0))) {
+            continue;
+        }
+        candidates.emplace_back((int) b, (int) a);
+    }
+
+    sort(candidates.begin(), candidates.end(), [](const pair<int,int>& f, const pair<int,int>& g) {
+        return make_tuple(abs(f.second), f.first, f.second < 0)
+            < make_tuple(abs(g.second), g.first, g.second < 0);
+    });
+    candidates.erase(unique(candidates.begin(), candidates.end()), candidates.end());
+    return complete;
+}
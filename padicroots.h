@@ -0,0 +1,50 @@
+#ifndef PADICROOTS_H
+#define PADICROOTS_H
+
+#include <utility>
+#include <vector>
+#include "polynomial.h"
+
+/**
+ * Rational roots of an integer polynomial by p-adic lifting.
+ *
+ * Every rational root -b/a of p, with a prime to some prime q, reduces to
+ * a root of p modulo q. The roots modulo q are found directly (see
+ * ModPolynomial::roots), each is lifted by Newton's iteration to a root
+ * modulo a power of q large enough to hold lead(p) times any real root,
+ * and that product is then read off as an integer. None of this depends
+ * on how many divisors the coefficients of p have.
+ */
+
+/**
+ * The roots are first found modulo the largest primes below this limit.
+ */
+const unsigned long long padicPrimeLimit = 1ULL << 20;
+
+/**
+ * How many primes are tried in search of one modulo which every root of
+ * p is simple.
+ */
+const int padicPrimeTrials = 8;
+
+/**
+ * Candidate linear factors of p from its roots modulo a prime.
+ *
+ * The candidates still have to be verified. If some prime is found
+ * modulo which every root of p is simple (in particular, if p has no
+ * roots modulo it), each root lifts uniquely and the candidates include
+ * every rational root of p. Otherwise roots that are multiple modulo the
+ * prime are lifted as roots of the lowest derivative of p that has them
+ * as simple roots. That finds a rational root of multiplicity k whenever
+ * the kth derivative of p does not vanish at it modulo the prime, but it
+ * is no longer guaranteed to find them all.
+ *
+ * @param p a polynomial with integer coefficients
+ * @param candidates output: (b, a) pairs denoting factors ax + b, with
+ *                   b > 0 (or 0 and a == 1), in the order tryToFactor
+ *                   would reach them, without repeats
+ * @return true if every rational root of p is among the candidates
+ */
+bool padicRootCandidates(const Polynomial& p, std::vector<std::pair<int,int>>& candidates);
+
+#endif
@@ -1,111 +1,732 @@
 #include "polynomial.h"
+#include "batcheval.h"
+#include "cyclotomic.h"
+#include "deflation.h"
+#include "divisors.h"
+#include "integerfactor.h"
+#include "lowdegree.h"
+#include "numericroots.h"
+#include "padicroots.h"
+#include "reciprocal.h"
+#include "rootsieve.h"
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <numeric>
+#include <sstream>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 using namespace std;
 
+// Candidate factors are screened this many at a time, one per lane of
+// the widest batch evaluation kernel.
+const size_t candidateBatch = 16;
+
+// Primes used to sieve candidate roots (--sieve-count, --sieve-primes),
+// and whether to report the sieve's rejection rate (--sieve-stats).
+vector<unsigned long long> sievePrimes = RootSieve::defaultPrimes(RootSieve::defaultPrimeCount);
+bool reportSieve = false;
+
+// How rational roots are found (--roots): by p-adic lifting, falling back
+// to the divisor search only when lifting cannot account for every root,
+// or by the divisor search alone.
+enum RootEngine { padicEngine, divisorEngine };
+RootEngine rootEngine = padicEngine;
+
+// Whether the divisor search substitutes x = y / a_n (--monic): when that
+// leaves fewer candidates, always, or never.
+enum MonicSearch { monicAuto, monicAlways, monicNever };
+MonicSearch monicSearch = monicAuto;
+
 
 /**
- * Attempt to find a linear factor of a polynomial. 
- * 
- * @param p the polynomial being factored, of degree 2 or higher
- * @param factor output: a linear factor of p or Polynomial() if no factor could be found
- * @param quotient output: the quotient p/factor if a linear factor of p was found, or Polynomial() if 
- *                         no factor could be found
+ * @return true if d divides v, where 0 is taken to divide only 0
+ */
+bool dividesValue(long long d, long long v)
+{
+  if (d == 0)
+    return v == 0;
+  if (d == 1 || d == -1)
+    return true;
+  return v % d == 0;
+}
+
+/**
+ * Test whether a candidate that has passed the modular sieve is a linear
+ * factor of p.
+ *
+ * The candidate is bounded in floating-point interval arithmetic, and
+ * tested exactly by evaluating a^n p(-b/a) only if that interval contains
+ * zero; the interval also rules out candidates whose value is too large
+ * to evaluate exactly. Only a candidate that passes both is divided out
+ * to obtain the quotient.
+ *
+ * @param p the polynomial being factored
+ * @param candidate a (b, a) pair denoting the candidate factor ax + b
+ * @param quotient output: p/(ax + b), if ax + b divides p
+ * @return true if ax + b divides p
+ */
+bool isFactor(const Polynomial& p, const pair<int,int>& candidate, Polynomial& quotient)
+{
+  if (!p.mayVanishAt(candidate.first, candidate.second))
+    return false;
+  long long value;
+  if (p.evaluateAt(candidate.first, candidate.second, value) && value != 0)
+    return false;
+  quotient = p / Polynomial (candidate.first, candidate.second);
+  return quotient != Polynomial();
+}
+
+/**
+ * The primitive linear factor with the same root as ax + b, signed the
+ * way tryToFactor finds it: with b > 0, or as x itself for the root 0.
+ *
+ * @return the (b, a) pair of that factor
+ */
+pair<int,int> canonicalFactor(int b, int a)
+{
+  int g = gcd(b, a);
+  b /= g;
+  a /= g;
+  if (b < 0 || (b == 0 && a < 0))
+    {
+      b = -b;
+      a = -a;
+    }
+  return make_pair(b, a);
+}
+
+/**
+ * Whether tryToFactor, searching p, reaches the canonical factor f
+ * before g: by increasing a, then increasing b, the negative root first.
  */
-void tryToFactor(const Polynomial& p, Polynomial& factor, Polynomial& quotient)
+bool precedes(const pair<int,int>& f, const pair<int,int>& g)
 {
+  return make_tuple(abs(f.second), f.first, f.second < 0)
+    < make_tuple(abs(g.second), g.first, g.second < 0);
+}
+
+/**
+ * The order in which irreducible factors of degree 2 or more are printed:
+ * by increasing degree, then by their coefficients from the highest
+ * power down.
+ */
+bool precedesNonlinear(const Polynomial& f, const Polynomial& g)
+{
+  if (f.getDegree() != g.getDegree())
+    return f.getDegree() < g.getDegree();
+  for (int i = f.getDegree(); i >= 0; --i)
+    if (f.getCoeff(i) != g.getCoeff(i))
+      return f.getCoeff(i) < g.getCoeff(i);
+  return false;
+}
+
+/**
+ * Divide out of p each candidate factor that divides it, as many times as
+ * it does, until p is down to a quadratic.
+ *
+ * The candidates are screened by the sieve once, as a batch, and then
+ * each is tested exactly once, in order, except that one that divides p
+ * is tested again on the quotient for a repeated root. None need be
+ * tested again after a later candidate is divided out: the roots of the
+ * quotient are among those of p, and for the same reason a candidate
+ * the sieve rejects for p stays rejected for any quotient of p, so the
+ * sieve need not be set up again either.
+ *
+ * @param p the polynomial being factored; output: p with the factors found
+ *          divided out
+ * @param sieve a sieve set up for p, or for a multiple of p
+ * @param candidates (b, a) pairs denoting candidate factors ax + b
+ * @param found output: the canonical (b, a) pairs of the factors divided
+ *              out are appended to this
+ * @return the number of factors divided out
+ */
+int divideOut(Polynomial& p, RootSieve& sieve, const vector<pair<int,int>>& candidates,
+              vector<pair<int,int>>& found)
+{
+  int count = 0;
+  if (candidates.empty())
+    return count;
+  vector<bool> survivors = sieve.screen(candidates);
+  Polynomial quotient;
+  for (size_t i = 0; i < candidates.size() && p.getDegree() > 2; ++i)
+    {
+      if (!survivors[i])
+        continue;
+      while (p.getDegree() > 2 && isFactor(p, candidates[i], quotient))
+        {
+          found.push_back(canonicalFactor(candidates[i].first, candidates[i].second));
+          p = quotient;
+          ++count;
+        }
+    }
+  return count;
+}
+
+/**
+ * Divide out of a polynomial its linear factors, by searching every
+ * candidate factor its coefficients allow.
+ *
+ * The candidates, and the filters on them, are derived once from p as
+ * it is on entry, and the search walks through them once, a batch at a
+ * time, dividing out factors as it finds them (see divideOut). Every
+ * root of a quotient is a root of p, so what rules a candidate out for
+ * p rules it out for the quotient too, and the search never has to
+ * start over: its cost is proportional to the number of candidates, not
+ * to that times the number of roots.
+ *
+ * @param p the polynomial being factored; output: p with its linear
+ *          factors divided out, down to a quadratic, which is left to
+ *          factorLowDegree
+ * @param sieve the root sieve, which will be set up for p
+ * @param found output: the canonical (b, a) pairs of the factors divided
+ *              out are appended to this
+ */
+void tryToFactor(Polynomial& p, RootSieve& sieve, vector<pair<int,int>>& found)
+{
+  while (p.getDegree() > 2 && p.getCoeff(0) == 0)
+    {
+      p = p / Polynomial({Term(1,1)}); // x
+      found.emplace_back(0, 1);
+    }
+  if (p.getDegree() < 3)
+    return;
+
   // If p is divisible by any linear factor ax + b, then a must divide evenly into
   // the highest-degree coefficient of p and b must divide evenly into
   // the lowest-degree coefficient of p.  
   int highestC = abs(p.getCoeff(p.getDegree()));
   int lowestC =  abs(p.getCoeff(0));
-  if (lowestC == 0)
-	{
-	  factor = Polynomial({Term(1,1)}); // x
-	  quotient = p / factor;
-	  return;
-	}
-  for (int a = 1; a <= highestC; ++a)
-    if (highestC % a == 0)
-      for (int b = 1; b <= lowestC; ++b)
-        if (lowestC % b == 0) {
-          // We'll need to check for various combinations of plus/minus signs.
-          factor = Polynomial (b, a);
-          quotient = p / factor;
-          if (quotient != Polynomial()) {
-            return;
-          }
-          factor = Polynomial(b, -a);
-          quotient = p / factor;
-          if (quotient != Polynomial()) {
-            return;
-          }
-          factor = Polynomial(-b, a);
-          quotient = p / factor;
-          if (quotient != Polynomial()) {
+  // Descartes' rule of signs: with no sign variations in p(x) there are no
+  // positive roots, and with none in p(-x) no negative ones. This is
+  // cheap enough to run before anything else is computed.
+  int positiveVariations, negativeVariations;
+  p.signVariations(positiveVariations, negativeVariations);
+  bool positiveRoots = positiveVariations > 0;
+  bool negativeRoots = negativeVariations > 0;
+  if (!positiveRoots && !negativeRoots)
+    return;
+
+  // Only the divisors themselves are visited, in increasing order, so the
+  // cost of the search depends on how many divisors the coefficients have
+  // rather than on their magnitude.
+  vector<unsigned long long> aDivisors = divisorsOf(highestC);
+  vector<unsigned long long> bDivisors = divisorsOf(lowestC);
+
+  // ax + b has the root -b/a, and (b, -a) and (-b, a) the root b/a. Any
+  // root beyond the bounds on p's real roots cannot be one, and since b
+  // increases along bDivisors, once b/a passes both bounds so will the
+  // rest of that row.
+  long double positiveBound, negativeBound;
+  p.rootBounds(positiveBound, negativeBound);
+  long double bound = max(positiveBound, negativeBound);
+
+  // If ax + b divides p then p(1) = (a + b) q(1) and p(-1) = (b - a) q(-1)
+  // for an integer polynomial q, so a + b must divide p(1) and b - a must
+  // divide p(-1). Values too large to compute exactly are not used.
+  long long valueAtOne, valueAtMinusOne;
+  bool knownAtOne = p.evaluate(1, valueAtOne);
+  bool knownAtMinusOne = p.evaluate(-1, valueAtMinusOne);
+  auto admissible = [&](long long b, long long a) {
+    return (!knownAtOne || dividesValue(a + b, valueAtOne))
+      && (!knownAtMinusOne || dividesValue(b - a, valueAtMinusOne));
+  };
+
+  sieve.setPolynomial(p);
+  vector<pair<int,int>> batch;
+  // Queue the candidates with the roots -b/a and b/a, and search them a
+  // batch at a time; false once p is down to a quadratic.
+  auto consider = [&](int b, int a) {
+    // We'll need to check for various combinations of plus/minus signs.
+    if (negativeRoots && b <= a * negativeBound && admissible(b, a))
+      batch.emplace_back(b, a);
+    if (positiveRoots && b <= a * positiveBound) {
+      if (admissible(b, -a))
+        batch.emplace_back(b, -a);
+      if (admissible(-b, a))
+        batch.emplace_back(-b, a);
+    }
+    if (batch.size() >= candidateBatch) {
+      divideOut(p, sieve, batch, found);
+      batch.clear();
+    }
+    return p.getDegree() > 2;
+  };
+
+  // Substituting x = y / a_n makes a_n^(n-1) p(y / a_n) monic, with
+  // integer roots only: y = -b a_n / a for each root -b/a of p, and so a
+  // divisor of a_0 a_n. Each rational root is then reached once, from a
+  // one-dimensional search, where the pairs of divisors reach it once for
+  // every common factor of b and a. There are fewer such divisors exactly
+  // when a_0 and a_n have a prime in common. The monic polynomial itself
+  // is never formed: each y is tested on p as the root y / a_n in lowest
+  // terms.
+  unsigned long long product = (unsigned long long) lowestC * highestC;
+  bool monic = monicSearch == monicAlways
+    || (monicSearch == monicAuto
+        && divisorCount(product) < aDivisors.size() * bDivisors.size());
+  if (monic)
+    {
+      for (unsigned long long y : divisorsOf(product))
+        {
+          if (y > highestC * bound)
+            break;
+          int g = gcd((long long) y, (long long) highestC);
+          if (!consider((int) (y / g), highestC / g))
             return;
-          }
         }
-  factor = quotient = Polynomial();
+    }
+  else
+    for (int a : aDivisors)
+      for (int b : bDivisors) {
+        if (b > a * bound)
+          break;
+        if (!consider(b, a))
+          return;
+      }
+  divideOut(p, sieve, batch, found);
 }
 
 /**
- * Prints the linear factors (ax+b where a and b are integers) of 
- * a polynomial.
+ * Divide out of p the linear factors suggested by approximating its roots
+ * numerically.
+ *
+ * Only rationals close to a real approximation, with a numerator and
+ * denominator that tryToFactor would also have tried, are proposed, and
+ * each one is verified exactly before it is divided out. The
+ * approximations never rule a candidate out: whatever they miss is left
+ * in p for the exhaustive search.
+ *
+ * @param p the polynomial being factored; output: p with the factors found
+ *          divided out
+ * @param sieve the root sieve, which will be set up for p
+ * @param found output: the canonical (b, a) pairs of the factors divided
+ *              out are appended to this
+ */
+void seedFactors(Polynomial& p, RootSieve& sieve, vector<pair<int,int>>& found)
+{
+  while (p.getDegree() > 2 && p.getCoeff(0) == 0)
+    {
+      p = p / Polynomial({Term(1,1)});
+      found.emplace_back(0, 1);
+    }
+  if (p.getDegree() < 3 || p.getDegree() > maxApproximatedDegree)
+    return;
+
+  vector<pair<int,int>> proposals
+    = nearbyRationals(approximateRoots(p), divisorsOf(abs(p.getCoeff(p.getDegree()))),
+                      divisorsOf(abs(p.getCoeff(0))));
+  sieve.setPolynomial(p);
+  divideOut(p, sieve, proposals, found);
+}
+
+/**
+ * Divide out of p the linear factors found by p-adic lifting.
+ *
+ * Each round lifts the roots of p modulo a prime, and divides out those
+ * that are verified to be rational roots. Once a round's candidates are
+ * known to include every rational root, nothing more can be found.
+ *
+ * @param p the polynomial being factored; output: p with the factors found
+ *          divided out
+ * @param sieve the root sieve, which will be set up for p
+ * @param found output: the canonical (b, a) pairs of the factors divided
+ *              out are appended to this
+ * @return true if p is known to have no linear factors left (or is down
+ *         to a quadratic), false if the divisor search is still needed
+ */
+bool padicFactors(Polynomial& p, RootSieve& sieve, vector<pair<int,int>>& found)
+{
+  while (p.getDegree() > 2)
+    {
+      vector<pair<int,int>> candidates;
+      bool complete = padicRootCandidates(p, candidates);
+      sieve.setPolynomial(p);
+      int divided = divideOut(p, sieve, candidates, found);
+      if (complete)
+        return true;
+      if (divided == 0)
+        return false;
+    }
+  return true;
+}
+
+bool splitFactors (Polynomial p, RootSieve& sieve, vector<pair<int,int>>& found,
+                   vector<Polynomial>& irreducible, Polynomial& unfactored);
+
+/**
+ * Split a self-reciprocal polynomial through the polynomial r of half its
+ * degree (see halveReciprocal): r goes through splitFactors in its turn,
+ * and each of its factors is lifted back and split, in closed form or by
+ * factorOverIntegers, into at most two.
+ *
+ * @param p a primitive polynomial
+ * @param sieve the root sieve, which will be set up for r
+ * @param found output: the canonical (b, a) pairs of the factors x - 1
+ *              and x + 1 of p are appended to this
+ * @param irreducible output: the other irreducible factors of p are
+ *                    appended to this
+ * @return false, leaving found and irreducible as they were, if p is not
+ *         self-reciprocal, or if r or a lifted factor cannot be split
+ *         completely
+ */
+bool splitReciprocal (const Polynomial& p, RootSieve& sieve, vector<pair<int,int>>& found,
+                      vector<Polynomial>& irreducible)
+{
+  int minusOnes, plusOnes;
+  Polynomial half;
+  if (!halveReciprocal (p, minusOnes, plusOnes, half))
+    return false;
+  vector<pair<int,int>> halfFound;
+  vector<Polynomial> halfFactors;
+  Polynomial rest (1);
+  if (half.getDegree() > 0
+      && (!splitFactors (half, sieve, halfFound, halfFactors, rest) || rest.getDegree() != 0))
+    return false;
+  for (const pair<int,int>& f : halfFound)
+    halfFactors.push_back(Polynomial(f.first, f.second));
+
+  vector<Polynomial> lifted;
+  for (const Polynomial& g : halfFactors)
+    {
+      Polynomial h = liftReciprocal (g);
+      if (h.getDegree() < 0)
+        return false;
+      if (h.getDegree() > 4 || !factorLowDegree (h, lifted))
+        {
+          vector<Polynomial> split;
+          factorOverIntegers (h, split, rest);
+          if (rest.getDegree() != 0)
+            return false;
+          lifted.insert(lifted.end(), split.begin(), split.end());
+        }
+    }
+  found.insert(found.end(), minusOnes, canonicalFactor(-1, 1));
+  found.insert(found.end(), plusOnes, canonicalFactor(1, 1));
+  irreducible.insert(irreducible.end(), lifted.begin(), lifted.end());
+  return true;
+}
+
+/**
+ * Split a polynomial in x^k through q with p(x) == q(x^k) (see deflate):
+ * q goes through splitFactors in its turn, and each of its factors f is
+ * inflated to f(x^k) and split by formula or by factorOverIntegers.
+ *
+ * @param p a primitive polynomial
+ * @param k a common divisor, greater than 1, of the powers of p
+ * @param sieve the root sieve, which will be set up for q
+ * @param found output: the canonical (b, a) pairs of the factors x of p
+ *              are appended to this
+ * @param irreducible output: the other irreducible factors of p are
+ *                    appended to this
+ * @return false, leaving found and irreducible as they were, if q or an
+ *         inflated factor cannot be split completely
+ */
+bool splitDeflated (const Polynomial& p, int k, RootSieve& sieve, vector<pair<int,int>>& found,
+                    vector<Polynomial>& irreducible)
+{
+  vector<pair<int,int>> deflatedFound;
+  vector<Polynomial> deflatedFactors;
+  Polynomial rest (1);
+  if (!splitFactors (deflate (p, k), sieve, deflatedFound, deflatedFactors, rest)
+      || rest.getDegree() != 0)
+    return false;
+  for (const pair<int,int>& f : deflatedFound)
+    deflatedFactors.push_back(Polynomial(f.first, f.second));
+
+  int zeros = 0;
+  vector<Polynomial> inflated;
+  for (const Polynomial& f : deflatedFactors)
+    {
+      if (f.getDegree() == 1 && f.getCoeff(0) == 0)
+        {
+          zeros += k;
+          continue;
+        }
+      Polynomial h = inflate (f, k);
+      if (h.getDegree() < 0)
+        return false;
+      if (factorCyclotomic (h, inflated))
+        continue;
+      if (h.getDegree() == 2)
+        factorLowDegree (h, inflated);
+      else
+        {
+          vector<Polynomial> split;
+          factorOverIntegers (h, split, rest);
+          if (rest.getDegree() != 0)
+            return false;
+          inflated.insert(inflated.end(), split.begin(), split.end());
+        }
+    }
+  found.insert(found.end(), zeros, canonicalFactor(0, 1));
+  irreducible.insert(irreducible.end(), inflated.begin(), inflated.end());
+  return true;
+}
+
+/**
+ * Split a primitive polynomial into factors irreducible over the
+ * integers.
+ *
+ * Binomials and cyclotomic polynomials are factored by formula,
+ * polynomials in x^k through their deflation, and self-reciprocal
+ * polynomials at half their degree, before any search.
+ * Otherwise the linear factors are divided out, by p-adic lifting or
+ * from numeric approximations to the roots and then by exhaustive
+ * search, which stop at a quadratic, since factorLowDegree solves that
+ * outright, as it does a cubic or quartic left with no linear factors.
+ * Anything larger that is left goes to factorOverIntegers.
+ *
+ * @param p a primitive polynomial
+ * @param sieve the root sieve
+ * @param found output: the canonical (b, a) pairs of linear factors of p
+ *              are appended to this
+ * @param irreducible output: the other irreducible factors of p, and
+ *                    possibly some more linear ones, are appended to this
+ * @param unfactored output: the product of the factors that could be
+ *                   neither split nor proven irreducible, or a constant;
+ *                   or, if the search failed, what it left of p
+ * @return false if the search failed to divide p exactly
+ */
+bool splitFactors (Polynomial p, RootSieve& sieve, vector<pair<int,int>>& found,
+                   vector<Polynomial>& irreducible, Polynomial& unfactored)
+{
+  if (factorCyclotomic (p, irreducible))
+    return true;
+  int k = exponentGcd (p);
+  if (k > 1 && splitDeflated (p, k, sieve, found, irreducible))
+    return true;
+  if (p.getDegree() >= minReciprocalDegree && splitReciprocal (p, sieve, found, irreducible))
+    return true;
+  bool done = rootEngine == padicEngine && padicFactors (p, sieve, found);
+  if (!done)
+    {
+      seedFactors (p, sieve, found);
+      tryToFactor (p, sieve, found);
+    }
+  if (p.getDegree() < 0)
+    {
+      unfactored = p;
+      return false;
+    }
+  if (p.getDegree() == 1)
+    found.push_back(canonicalFactor(p.getCoeff(0), p.getCoeff(1)));
+  else if (p.getDegree() > 1
+           && (p.getDegree() > 4 || !factorLowDegree (p, irreducible)))
+    {
+      vector<Polynomial> split;
+      factorOverIntegers (p, split, unfactored);
+      irreducible.insert(irreducible.end(), split.begin(), split.end());
+    }
+  return true;
+}
+
+/**
+ * Prints the factors of a polynomial that are irreducible over the
+ * integers: first its linear factors (ax+b where a and b are integers),
+ * then those of higher degree.
+ *
+ * The content of p, unless it is just a sign, is printed first, as a
+ * factor of its own, and only the primitive part of p is searched: the
+ * divisors of its leading and constant coefficients are all the search
+ * has to try.
+ *
+ * The factors are found by splitFactors, in no particular order, and
+ * printed with the linear factors first, by precedes, and those of
+ * higher degree following, by precedesNonlinear. The last factor printed
+ * is what remains, and so carries the sign of p if its content is -1.
+ * If factorOverIntegers cannot finish, the unfactored part is printed
+ * last as such.
  * 
  * @param p a polynomial
- * @return true if p has at least one linear factor
  */
 void factor (Polynomial p)
 {
-  while (p.getDegree() > 1)
+  int content = (p.getDegree() > 0) ? p.content() : 1;
+  bool separateContent = content != 1 && content != -1;
+  if (p.getDegree() > 0)
+    p = p.primitivePart();
+  Polynomial original = separateContent ? p : p * content;
+  RootSieve sieve (sievePrimes);
+  vector<pair<int,int>> found;
+  vector<Polynomial> irreducible;
+  Polynomial unfactored (1);
+  if (!splitFactors (p, sieve, found, irreducible, unfactored))
+  {
+      cout << "could not factor: " << unfactored << endl;
+  }
+  else
   {
-      Polynomial factor;
-      Polynomial quotient;
-      tryToFactor (p, factor, quotient);
-      if (factor == Polynomial() || quotient == Polynomial())
+    vector<Polynomial> nonlinear;
+    for (const Polynomial& f : irreducible)
+      if (f.getDegree() == 1)
+        found.push_back(canonicalFactor(f.getCoeff(0), f.getCoeff(1)));
+      else
+        nonlinear.push_back(f);
+    sort(found.begin(), found.end(), precedes);
+    sort(nonlinear.begin(), nonlinear.end(), precedesNonlinear);
+
+    vector<Polynomial> factors;
+    for (const pair<int,int>& f : found)
+      factors.push_back(Polynomial(f.first, f.second));
+    factors.insert(factors.end(), nonlinear.begin(), nonlinear.end());
+
+    // When the factorization is complete, it is whichever factor sorts
+    // last that ends up as the remainder. The factors then multiply out
+    // to the original up to sign, so the remainder is that factor with
+    // the sign fixed up, and no division is needed.
+    bool complete = unfactored.getDegree() == 0;
+    Polynomial rest = original;
+    if (complete && !factors.empty())
       {
-        break;
+        rest = factors.back();
+        factors.pop_back();
       }
-      else
+    auto leadingSign = [](const Polynomial& f) {
+      return (f.getCoeff(f.getDegree()) < 0) ? -1 : 1;
+    };
+    int sign = leadingSign(original) * leadingSign(rest);
+    if (separateContent)
+      cout << "factor: " << content << endl;
+    for (const Polynomial& factor : factors)
       {
-        cout << "factor: " << factor  << endl;
-        p = quotient;
+        cout << "factor: " << factor << endl;
+        if (complete)
+          sign *= leadingSign(factor);
+        else
+          rest = rest / factor;
       }
+    if (complete)
+      cout << "factor: " << rest * sign << endl;
+    else
+      cout << "could not factor: " << rest << endl;
   }
-  if (p.getDegree() < 0)
-  {
-      cout << "could not factor: " << p << endl;
-  }
-  else if (p.getDegree() <= 1)
-  {
-    cout << "factor: " << p << endl;
-  }
-  else {
-    cout << "could not factor: " << p << endl;
-  }
+  if (reportSieve)
+    {
+      long long tested = sieve.getTested();
+      long long rejected = sieve.getRejected();
+      cerr << "sieve: " << sievePrimes.size() << " primes, " << tested
+           << " candidates tested, " << rejected << " rejected";
+      if (tested > 0)
+        cerr << " (" << fixed << setprecision(1) << 100.0 * rejected / tested << "%)";
+      cerr << endl;
+    }
+}
+
+/**
+ * Parse one of the command-line options.
+ *
+ * @param option a command-line argument starting with "--"
+ * @return false if the option is not recognized or its value is invalid
+ */
+bool parseOption (const char* option)
+{
+  if (strcmp(option, "--sieve-stats") == 0)
+    {
+      reportSieve = true;
+      return true;
+    }
+  if (strcmp(option, "--roots=padic") == 0)
+    {
+      rootEngine = padicEngine;
+      return true;
+    }
+  if (strcmp(option, "--roots=divisors") == 0)
+    {
+      rootEngine = divisorEngine;
+      return true;
+    }
+  if (strcmp(option, "--monic=auto") == 0)
+    {
+      monicSearch = monicAuto;
+      return true;
+    }
+  if (strcmp(option, "--monic=always") == 0)
+    {
+      monicSearch = monicAlways;
+      return true;
+    }
+  if (strcmp(option, "--monic=never") == 0)
+    {
+      monicSearch = monicNever;
+      return true;
+    }
+  if (strncmp(option, "--sieve-count=", 14) == 0)
+    {
+      int count = atoi(option + 14);
+      if (count < 0 || count > 64)
+        return false;
+      sievePrimes = RootSieve::defaultPrimes(count);
+      return true;
+    }
+  if (strncmp(option, "--sieve-primes=", 15) == 0)
+    {
+      sievePrimes.clear();
+      istringstream in (option + 15);
+      string item;
+      while (getline(in, item, ','))
+        {
+          unsigned long long q = strtoull(item.c_str(), nullptr, 10);
+          if (!isPrime(q) || q >= batchModulusLimit)
+            return false;
+          sievePrimes.push_back(q);
+        }
+      return true;
+    }
+  return false;
 }
 
 /**
  * Run as 
- *   ./polyfactor cn cn-1 ... c1 c0
+ *   ./polyfactor [options] cn cn-1 ... c1 c0
  * where n is the degree of the polynomial and the c_i are integer coefficients
  * defining a polynomial c0 + c1 * x + c2 * x^2 + ... + cn * x^n
+ *
+ * Options:
+ *   --roots=padic          find rational roots by p-adic lifting, searching
+ *                          the divisors of the coefficients only when that
+ *                          cannot rule out further roots (the default)
+ *   --roots=divisors       always search the divisors of the coefficients
+ *   --monic=auto           have the divisor search try the roots of the
+ *                          monic a_n^(n-1) p(y / a_n) instead when there
+ *                          are fewer of them (the default)
+ *   --monic=always         always search the roots of the monic polynomial
+ *   --monic=never          always search pairs of divisors
+ *   --sieve-count=k        sieve candidate roots with the k largest primes
+ *                          below 2^26 (default 2; 0 disables the sieve)
+ *   --sieve-primes=p,q,..  sieve with these primes, each below 2^26
+ *   --sieve-stats          report the sieve's rejection rate on stderr
  * 
  */
 int main(int argc, char **argv)
 {
-  if (argc == 1)
+  vector<int> coefficientArgs;
+  for (int i = 1; i < argc; ++i)
+    {
+      if (strncmp(argv[i], "--", 2) == 0)
+        {
+          if (!parseOption(argv[i]))
+            {
+              cerr << "Unrecognized option: " << argv[i] << endl;
+              return 1;
+            }
+        }
+      else
+        coefficientArgs.push_back(i);
+    }
+  if (coefficientArgs.empty())
 	{
-	  cerr << "Usage: ./" << argv[0] << " cn ... c1 c0" << endl;
+	  cerr << "Usage: ./" << argv[0] << " [options] cn ... c1 c0" << endl;
 	  return 1;
 	}
-  int degree = argc - 1;
+  int degree = coefficientArgs.size();
   int* coefficients = new int[degree];
   for (int i = 0; i < degree; ++i)
-     coefficients[degree-i-1] = atoi(argv[i+1]);
+     coefficients[degree-i-1] = atoi(argv[coefficientArgs[i]]);
 
   Polynomial poly (degree, coefficients);
   delete[] coefficients;
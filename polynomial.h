@@ -4,16 +4,35 @@
 #include <iostream>
 #include <initializer_list>
 #include <list>
+#include <vector>
 #include "term.h"
 
 class Polynomial {
 public:
+    typedef std::list<Term>::const_iterator const_iterator;
+
     Polynomial();
     Polynomial(int b, int a = 0);
     Polynomial(std::initializer_list<Term> terms);
+    Polynomial(const std::vector<Term>& terms);
     Polynomial(int nC, int coeff[]);
     int getCoeff(int power) const;
     int getDegree() const;
+    const_iterator begin() const;
+    const_iterator end() const;
+    bool evaluate(long long x, long long& value) const;
+    bool evaluateAt(long long b, long long a, long long& value) const;
+    bool mayVanishAt(long long b, long long a) const;
+    unsigned long long evaluateMod(long long x, unsigned long long modulus) const;
+    std::vector<unsigned long long> evaluateMod(const std::vector<long long>& xs,
+                                                unsigned long long modulus) const;
+    void evaluate(const std::vector<long long>& xs, std::vector<long long>& values,
+                  std::vector<bool>& exact) const;
+    bool tabulate(long long first, long long count, std::vector<long long>& values) const;
+    void rootBounds(long double& positive, long double& negative) const;
+    void signVariations(int& positive, int& negative) const;
+    int content() const;
+    Polynomial primitivePart() const;
     Polynomial operator+ (const Polynomial& p) const;
     Polynomial operator* (int scale) const;
     Polynomial operator* (Term term) const;
@@ -21,10 +40,14 @@ public:
     Polynomial operator/ (const Polynomial& denominator) const;
     bool operator== (const Polynomial& p) const;
 
+    static const int estrinThreshold = 32;
+
 private:
     int degree;
     std::list<Term> terms;
     void normalize();
+    unsigned long long hornerMod(unsigned long long x, unsigned long long modulus) const;
+    unsigned long long estrinMod(unsigned long long x, unsigned long long modulus) const;
     friend std::ostream& operator<< (std::ostream&, const Polynomial&);
     bool sanityCheck() const;
 };
@@ -0,0 +1,135 @@
+#include "polynomialevaluator.h"
+#include <limits>
+
+using namespace std;
+
+
+namespace {
+
+/**
+ * Horner's rule over N+1 coefficients, unrolled at compile time:
+ * c[0] + x (c[1] + x (... + x c[N])).
+ */
+template <int N>
+struct UnrolledHorner {
+    static double evaluate(const double* c, double x) {
+        return c[0] + x * UnrolledHorner<N - 1>::evaluate(c + 1, x);
+    }
+};
+
+template <>
+struct UnrolledHorner<0> {
+    static double evaluate(const double* c, double) {
+        return c[0];
+    }
+};
+
+/**
+ * c[0] + c[1] x + ... + c[7] x^7 as an Estrin tree: the four pairs, and
+ * then the two pairs of pairs, are independent of one another.
+ */
+inline double estrin8(const double* c, double x, double x2, double x4) {
+    double p01 = c[0] + c[1] * x;
+    double p23 = c[2] + c[3] * x;
+    double p45 = c[4] + c[5] * x;
+    double p67 = c[6] + c[7] * x;
+    return (p01 + p23 * x2) + x4 * (p45 + p67 * x2);
+}
+
+inline double power(double x, int n) {
+    double result = 1.0;
+    while (n > 0) {
+        if (n & 1) {
+            result *= x;
+        }
+        x *= x;
+        n >>= 1;
+    }
+    return result;
+}
+
+}
+
+
+template <int Degree>
+double PolynomialEvaluator::evaluateFixed(const PolynomialEvaluator& e, double x) {
+    return UnrolledHorner<Degree>::evaluate(e.coeffs.data(), x);
+}
+
+double PolynomialEvaluator::evaluateBad(const PolynomialEvaluator&, double) {
+    return numeric_limits<double>::quiet_NaN();
+}
+
+double PolynomialEvaluator::evaluateSparse(const PolynomialEvaluator& e, double x) {
+    // coeffs holds the nonzero coefficients from the highest power down;
+    // gaps[i] is the drop in power after coeffs[i], the last gap being
+    // the lowest power itself.
+    double result = 0.0;
+    for (size_t i = 0; i < e.coeffs.size(); ++i) {
+        result = (result + e.coeffs[i]) * power(x, e.gaps[i]);
+    }
+    return result;
+}
+
+double PolynomialEvaluator::evaluateBlocked(const PolynomialEvaluator& e, double x) {
+    // coeffs holds the 8-coefficient blocks from the highest block down.
+    double x2 = x * x;
+    double x4 = x2 * x2;
+    double x8 = x4 * x4;
+    const double* block = e.coeffs.data();
+    double result = 0.0;
+    for (int i = 0; i < e.blocks; ++i, block += 8) {
+        result = result * x8 + estrin8(block, x, x2, x4);
+    }
+    return result;
+}
+
+
+PolynomialEvaluator::PolynomialEvaluator(const Polynomial& p)
+    : plan(evaluateBad), blocks(0) {
+    int degree = p.getDegree();
+    if (degree < 0) {
+        return;
+    }
+
+    vector<double> dense(degree + 1, 0.0);
+    int nonzero = 0;
+    for (const Term& term : p) {
+        dense[term.power] += term.coefficient;
+    }
+    for (double c : dense) {
+        if (c != 0.0) {
+            ++nonzero;
+        }
+    }
+
+    if (degree <= maxFixedDegree) {
+        static const Plan fixedPlans[maxFixedDegree + 1] = {
+            evaluateFixed<0>, evaluateFixed<1>, evaluateFixed<2>,
+            evaluateFixed<3>, evaluateFixed<4>, evaluateFixed<5>,
+            evaluateFixed<6>, evaluateFixed<7>, evaluateFixed<8>
+        };
+        coeffs = dense;
+        plan = fixedPlans[degree];
+    } else if (4 * nonzero <= degree + 1) {
+        int previous = -1;
+        for (int power = degree; power >= 0; --power) {
+            if (dense[power] != 0.0) {
+                if (previous >= 0) {
+                    gaps.push_back(previous - power);
+                }
+                coeffs.push_back(dense[power]);
+                previous = power;
+            }
+        }
+        gaps.push_back(previous);
+        plan = evaluateSparse;
+    } else {
+        blocks = (degree + 8) / 8;
+        dense.resize(8 * blocks, 0.0);
+        for (int i = blocks - 1; i >= 0; --i) {
+            coeffs.insert(coeffs.end(), dense.begin() + 8 * i, dense.begin() + 8 * i + 8);
+        }
+        plan = evaluateBlocked;
+    }
+}
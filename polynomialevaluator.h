@@ -0,0 +1,48 @@
+#ifndef POLYNOMIALEVALUATOR_H
+#define POLYNOMIALEVALUATOR_H
+
+#include <vector>
+#include "polynomial.h"
+
+/**
+ * A polynomial compiled for repeated floating-point evaluation.
+ *
+ * Construction inspects the polynomial once and picks an evaluation
+ * plan; evaluation then just runs that plan, with no tests of the
+ * polynomial's degree or sparsity:
+ *
+ *  - degree up to maxFixedDegree: a fully unrolled Horner instantiated for
+ *    exactly that degree;
+ *  - few nonzero terms: Horner over the nonzero terms only, stepping
+ *    across each gap in the powers with a precomputed exponent;
+ *  - otherwise: blocks of 8 coefficients, each evaluated by an unrolled
+ *    Estrin tree, chained together by Horner in x^8.
+ */
+class PolynomialEvaluator {
+public:
+    explicit PolynomialEvaluator(const Polynomial& p);
+
+    double operator() (double x) const;
+
+    static const int maxFixedDegree = 8;
+
+private:
+    typedef double (*Plan)(const PolynomialEvaluator&, double);
+
+    Plan plan;
+    std::vector<double> coeffs;   // laid out in the order the plan consumes them
+    std::vector<int> gaps;        // sparse plan: power differences between terms
+    int blocks;                   // dense plan: number of 8-coefficient blocks
+
+    static double evaluateBad(const PolynomialEvaluator& e, double x);
+    static double evaluateSparse(const PolynomialEvaluator& e, double x);
+    static double evaluateBlocked(const PolynomialEvaluator& e, double x);
+    template <int Degree>
+    static double evaluateFixed(const PolynomialEvaluator& e, double x);
+};
+
+inline double PolynomialEvaluator::operator() (double x) const {
+    return plan(*this, x);
+}
+
+#endif
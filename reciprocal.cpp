@@ -0,0 +1,146 @@
+#include "reciprocal.h"
+#include <climits>
+#include <vector>
+
+using namespace std;
+
+
+// Dense integer polynomials, lowest power first.
+typedef vector<long long> Dense;
+
+// Wide enough for x^k + x^-k as a polynomial in x + 1/x up to the degrees
+// at which the half polynomial could still fit in an int.
+typedef __int128 Wide;
+
+static Dense toDense(const Polynomial& p) {
+    Dense d(p.getDegree() + 1, 0);
+    for (const Term& term : p) {
+        d[term.power] += term.coefficient;
+    }
+    return d;
+}
+
+/**
+ * @return false if a coefficient of w does not fit in an int
+ */
+static bool toPolynomial(const vector<Wide>& w, Polynomial& p) {
+    vector<int> c;
+    for (Wide x : w) {
+        if (x < INT_MIN || x > INT_MAX) {
+            return false;
+        }
+        c.push_back((int) x);
+    }
+    p = Polynomial(c.size(), c.data());
+    return true;
+}
+
+/**
+ * Replace d, which must vanish at root, by d / (x - root), by synthetic
+ * division from the top down.
+ */
+static void divideRoot(Dense& d, int root) {
+    Dense q(d.size() - 1);
+    long long carry = 0;
+    for (size_t i = q.size(); i > 0; --i) {
+        carry = d[i] + root * carry;
+        q[i - 1] = carry;
+    }
+    d = q;
+}
+
+/**
+ * sum += scale * term, or false on overflow.
+ */
+static bool addScaled(Wide& sum, Wide scale, Wide term) {
+    Wide product;
+    return !__builtin_mul_overflow(scale, term, &product) && !__builtin_add_overflow(sum, product, &sum);
+}
+
+/**
+ * With x^k + x^-k written V_k(y), y = x + 1/x, V_0 = 2, V_1 = y and
+ * V_(k+1) = y V_k - V_(k-1), q(x) / x^m is c_m + the sum over k of
+ * c_(m+k) V_k(y).
+ */
+bool halveReciprocal(const Polynomial& p, int& minusOnes, int& plusOnes, Polynomial& half) {
+    if (p.getDegree() < 1) {
+        return false;
+    }
+    Dense d = toDense(p);
+    int n = d.size() - 1;
+    if (d[0] == 0 || (d[0] != d[n] && d[0] != -d[n])) {
+        return false;
+    }
+    int sign = (d[0] == d[n]) ? 1 : -1;
+    for (int i = 0; i <= n; ++i) {
+        if (d[i] != sign * d[n - i]) {
+            return false;
+        }
+    }
+    minusOnes = plusOnes = 0;
+    if (sign < 0) {
+        divideRoot(d, 1);
+        ++minusOnes;
+    }
+    if (d.size() % 2 == 0) {
+        divideRoot(d, -1);
+        ++plusOnes;
+    }
+
+    int m = (d.size() - 1) / 2;
+    vector<Wide> r(m + 1, 0);
+    vector<Wide> previous {2}, current {0, 1};
+    r[0] = d[m];
+    for (int k = 1; k <= m; ++k) {
+        for (int i = 0; i <= k; ++i) {
+            if (!addScaled(r[i], d[m + k], current[i])) {
+                return false;
+            }
+        }
+        if (k == m) {
+            break;
+        }
+        vector<Wide> next(k + 2, 0);
+        for (int i = 0; i <= k; ++i) {
+            next[i + 1] = current[i];
+        }
+        for (size_t i = 0; i < previous.size(); ++i) {
+            if (__builtin_sub_overflow(next[i], previous[i], &next[i])) {
+                return false;
+            }
+        }
+        previous = current;
+        current = next;
+    }
+    return toPolynomial(r, half);
+}
+
+/**
+ * x^k g(x + 1/x) is the sum over j of g_j x^(k-j) (x^2 + 1)^j, expanded
+ * a row of Pascal's triangle at a time.
+ */
+Polynomial liftReciprocal(const Polynomial& g) {
+    int k = g.getDegree();
+    Dense c = toDense(g);
+    vector<Wide> lifted(2 * k + 1, 0);
+    vector<Wide> binomials {1};
+    for (int j = 0; j <= k; ++j) {
+        for (int i = 0; i <= j; ++i) {
+            if (!addScaled(lifted[k - j + 2 * i], c[j], binomials[i])) {
+                return Polynomial();
+            }
+        }
+        vector<Wide> next(j + 2, 1);
+        for (int i = 1; i <= j; ++i) {
+            if (__builtin_add_overflow(binomials[i - 1], binomials[i], &next[i])) {
+                return Polynomial();
+            }
+        }
+        binomials = next;
+    }
+    Polynomial result;
+    if (!toPolynomial(lifted, result)) {
+        return Polynomial();
+    }
+    return result;
+}
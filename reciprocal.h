@@ -0,0 +1,50 @@
+#ifndef RECIPROCAL_H
+#define RECIPROCAL_H
+
+#include "polynomial.h"
+
+/**
+ * Self-reciprocal polynomials, those whose coefficients read the same
+ * backwards (palindromic) or the same with the sign flipped
+ * (anti-palindromic), factored at half their degree.
+ *
+ * An anti-palindromic polynomial vanishes at 1, and at -1 too if its
+ * degree is even, and a palindromic one of odd degree vanishes at -1;
+ * dividing out those roots leaves a palindromic q of even degree 2m.
+ * Its roots come in pairs z, 1/z, so q(x) = x^m r(x + 1/x) for an integer
+ * polynomial r of degree m, found by writing each x^k + x^-k as a
+ * polynomial in y = x + 1/x. Each irreducible factor g of r of degree k
+ * then lifts back to the factor x^k g(x + 1/x) of q, which is either
+ * irreducible or the product of two factors of degree k, reciprocal to
+ * each other.
+ */
+
+/**
+ * Reciprocal halving is used only for polynomials of at least this
+ * degree; below it, the closed forms of factorLowDegree are as quick.
+ */
+const int minReciprocalDegree = 5;
+
+/**
+ * Split a self-reciprocal polynomial into its roots at 1 and -1 and a
+ * polynomial of half the remaining degree.
+ *
+ * @param p a polynomial with a nonzero constant term
+ * @param minusOnes output: how many factors x - 1 p has been split into
+ * @param plusOnes output: how many factors x + 1 p has been split into
+ * @param half output: r such that
+ *             p == (x - 1)^minusOnes (x + 1)^plusOnes x^m r(x + 1/x),
+ *             m being the degree of r
+ * @return false if p is not self-reciprocal, or a coefficient of r does
+ *         not fit in an int
+ */
+bool halveReciprocal(const Polynomial& p, int& minusOnes, int& plusOnes, Polynomial& half);
+
+/**
+ * @param g a polynomial of degree k
+ * @return x^k g(x + 1/x), or Polynomial() if a coefficient does not fit
+ *         in an int
+ */
+Polynomial liftReciprocal(const Polynomial& g);
+
+#endif
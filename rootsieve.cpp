@@ -0,0 +1,104 @@
+#include "rootsieve.h"
+#include "batcheval.h"
+#include "divisors.h"
+#include "modarith.h"
+#include <algorithm>
+
+using namespace std;
+
+
+/**
+ * @param primes the sieving primes, each below batchModulusLimit
+ */
+RootSieve::RootSieve(const vector<unsigned long long>& primes)
+    : degree(-1), primes(primes), tested(0), rejected(0) {
+}
+
+/**
+ * Reduce the coefficients of the polynomial to be sieved.
+ *
+ * @param p the polynomial whose roots are sought
+ */
+void RootSieve::setPolynomial(const Polynomial& p) {
+    degree = p.getDegree();
+    residues.clear();
+    for (unsigned long long q : primes) {
+        vector<double> c(max(degree, 0) + 1, 0.0);
+        for (const Term& term : p) {
+            c[term.power] = (double) addMod((Residue) c[term.power], toResidue(term.coefficient, q), q);
+        }
+        residues.push_back(c);
+    }
+}
+
+/**
+ * Screen candidate linear factors.
+ *
+ * @param candidates (b, a) pairs denoting candidate factors ax + b
+ * @return for each candidate, false if the sieve proves it is not a
+ *         factor and true if it might be one
+ */
+vector<bool> RootSieve::screen(const vector<pair<int,int>>& candidates) {
+    vector<bool> survivors(candidates.size(), degree >= 0);
+    tested += candidates.size();
+    if (degree < 0) {
+        rejected += candidates.size();
+        return survivors;
+    }
+
+    vector<size_t> alive;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        alive.push_back(i);
+    }
+    vector<double> points, values;
+    for (size_t k = 0; k < primes.size() && !alive.empty(); ++k) {
+        Residue q = primes[k];
+        // Candidates whose a is divisible by q cannot be screened by q.
+        vector<size_t> screened, unscreened;
+        points.clear();
+        for (size_t i : alive) {
+            Residue aInverse = invMod(toResidue(candidates[i].second, q), q);
+            if (aInverse == 0) {
+                unscreened.push_back(i);
+            } else {
+                screened.push_back(i);
+                Residue minusB = toResidue(-(long long) candidates[i].first, q);
+                points.push_back((double) mulMod(minusB, aInverse, q));
+            }
+        }
+        values.resize(points.size());
+        evaluateBatch(residues[k].data(), degree, points.data(), points.size(), (double) q, values.data());
+
+        alive = unscreened;
+        for (size_t j = 0; j < screened.size(); ++j) {
+            if (values[j] != 0) {
+                survivors[screened[j]] = false;
+                ++rejected;
+            } else {
+                alive.push_back(screened[j]);
+            }
+        }
+    }
+    return survivors;
+}
+
+long long RootSieve::getTested() const {
+    return tested;
+}
+
+long long RootSieve::getRejected() const {
+    return rejected;
+}
+
+/**
+ * The count largest primes below batchModulusLimit.
+ */
+vector<unsigned long long> RootSieve::defaultPrimes(int count) {
+    vector<unsigned long long> result;
+    for (unsigned long long q = batchModulusLimit - 1; (int) result.size() < count && q > 2; --q) {
+        if (isPrime(q)) {
+            result.push_back(q);
+        }
+    }
+    return result;
+}
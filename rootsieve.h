@@ -0,0 +1,46 @@
+#ifndef ROOTSIEVE_H
+#define ROOTSIEVE_H
+
+#include <utility>
+#include <vector>
+#include "polynomial.h"
+
+/**
+ * A modular sieve for candidate rational roots of one polynomial.
+ *
+ * ax + b can only divide p if a^n p(-b/a) == 0, and so only if
+ * p(-b * a^-1) == 0 modulo every prime not dividing a. The sieve keeps
+ * p's coefficients reduced modulo each of a handful of primes below
+ * batchModulusLimit and tests candidates against them, one prime at a
+ * time, through the SIMD batch kernel. Each prime only sees the
+ * candidates that passed the ones before it.
+ *
+ * A candidate the sieve rejects is certainly not a root. One it passes
+ * still has to be tested exactly.
+ *
+ * The counts of candidates tested and rejected accumulate across
+ * setPolynomial calls, so one sieve can follow a polynomial through a
+ * whole factoring run and report its overall rejection rate.
+ */
+class RootSieve {
+public:
+    explicit RootSieve(const std::vector<unsigned long long>& primes);
+
+    void setPolynomial(const Polynomial& p);
+    std::vector<bool> screen(const std::vector<std::pair<int,int>>& candidates);
+
+    long long getTested() const;
+    long long getRejected() const;
+
+    static std::vector<unsigned long long> defaultPrimes(int count);
+    static const int defaultPrimeCount = 2;
+
+private:
+    int degree;
+    std::vector<unsigned long long> primes;
+    std::vector<std::vector<double>> residues;   // residues[k][i]: c_i mod primes[k]
+    long long tested;
+    long long rejected;
+};
+
+#endif
@@ -0,0 +1,77 @@
+/*
+ * testCyclotomic.cpp
+ */
+
+#include "cyclotomic.h"
+
+#include <vector>
+
+#include "unittest.h"
+
+
+using namespace std;
+
+typedef vector<Polynomial> Factors;
+
+
+UnitTest (CyclotomicPolynomials) {
+	assertThat (cyclotomic(1), is(Polynomial(-1, 1)));
+	assertThat (cyclotomic(2), is(Polynomial(1, 1)));
+	assertThat (cyclotomic(6), is(Polynomial({Term(1, 2), Term(-1, 1), Term(1, 0)})));
+	assertThat (cyclotomic(12), is(Polynomial({Term(1, 4), Term(-1, 2), Term(1, 0)})));
+
+	// the first with a coefficient other than 0 and +-1
+	Polynomial p = cyclotomic(105);
+	assertThat (p.getDegree(), is(48));
+	assertThat (p.getCoeff(7), is(-2));
+	assertThat (p.getCoeff(41), is(-2));
+}
+
+UnitTest (CyclotomicBinomials) {
+	Factors factors;
+	// x^6 - 1
+	assertTrue (factorCyclotomic(Polynomial({Term(1, 6), Term(-1, 0)}), factors));
+	assertThat (factors, is(Factors{cyclotomic(1), cyclotomic(2), cyclotomic(3), cyclotomic(6)}));
+
+	// 8x^3 + 27 == (2x + 3)(4x^2 - 6x + 9)
+	factors.clear();
+	assertTrue (factorCyclotomic(Polynomial({Term(8, 3), Term(27, 0)}), factors));
+	assertThat (factors, is(Factors{Polynomial(3, 2), Polynomial({Term(4, 2), Term(-6, 1), Term(9, 0)})}));
+
+	// -x^6 + 16x^2 == -x^2 (x - 2)(x + 2)(x^2 + 4)
+	factors.clear();
+	assertTrue (factorCyclotomic(Polynomial({Term(-1, 6), Term(16, 2)}), factors));
+	assertThat (factors, is(Factors{Polynomial(0, 1), Polynomial(0, 1), Polynomial(-2, 1), Polynomial(2, 1),
+	                                Polynomial({Term(1, 2), Term(4, 0)})}));
+
+	// Neither coefficient of x^2 - 2, nor 2 in 2x^3 + 1, is a power.
+	factors.clear();
+	assertFalse (factorCyclotomic(Polynomial({Term(1, 2), Term(-2, 0)}), factors));
+	assertFalse (factorCyclotomic(Polynomial({Term(2, 3), Term(1, 0)}), factors));
+	assertTrue (factors.empty());
+}
+
+UnitTest (CyclotomicDeflated) {
+	Factors factors;
+	int degreeTen[] = {1, 0, 0, 0, 0, -1, 0, 0, 0, 0, 1}; // x^10 - x^5 + 1
+	assertTrue (factorCyclotomic(Polynomial(11, degreeTen), factors));
+	assertThat (factors, is(Factors{cyclotomic(6), cyclotomic(30)}));
+
+	factors.clear();
+	assertFalse (factorCyclotomic(Polynomial({Term(1, 4), Term(1, 1), Term(1, 0)}), factors));
+	assertFalse (factorCyclotomic(Polynomial({Term(1, 4), Term(3, 2), Term(1, 0)}), factors));
+	assertTrue (factors.empty());
+}
+
+UnitTest (CyclotomicMillion) {
+	Factors factors;
+	assertTrue (factorCyclotomic(Polynomial({Term(1, 1000000), Term(-1, 0)}), factors));
+	assertThat (factors.size(), is(49u));
+	int degree = 0;
+	for (const Polynomial& f : factors)
+		degree += f.getDegree();
+	assertThat (degree, is(1000000));
+	// Phi_1000000(x) == Phi_10(x^100000)
+	assertThat (factors.back().getDegree(), is(400000));
+	assertThat (factors.back().getCoeff(300000), is(-1));
+}
@@ -0,0 +1,30 @@
+/*
+ * testDeflation.cpp
+ */
+
+#include "deflation.h"
+
+#include "unittest.h"
+
+
+using namespace std;
+
+
+UnitTest (DeflationExponentGcd) {
+	assertThat (exponentGcd(Polynomial({Term(1, 6), Term(-3, 4), Term(2, 0)})), is(2));
+	assertThat (exponentGcd(Polynomial({Term(1, 9), Term(5, 3)})), is(3));
+	assertThat (exponentGcd(Polynomial({Term(1, 4), Term(1, 1), Term(1, 0)})), is(1));
+	assertThat (exponentGcd(Polynomial(7)), is(0));
+}
+
+UnitTest (DeflationRoundTrip) {
+	// x^6 - 3x^4 + 2 == q(x^2), q == y^3 - 3y^2 + 2
+	Polynomial p ({Term(1, 6), Term(-3, 4), Term(2, 0)});
+	Polynomial q ({Term(1, 3), Term(-3, 2), Term(2, 0)});
+	assertThat (deflate(p, 2), is(q));
+	assertThat (inflate(q, 2), is(p));
+	assertThat (deflate(p, 1), is(p));
+
+	assertThat (inflate(Polynomial(1, 1), 1000000), is(Polynomial({Term(1, 1000000), Term(1, 0)})));
+	assertThat (inflate(Polynomial({Term(1, 3), Term(1, 0)}), 1 << 30).getDegree(), is(-1));
+}
@@ -0,0 +1,61 @@
+/*
+ * testDivisors.cpp
+ */
+
+#include "divisors.h"
+
+#include <vector>
+
+#include "unittest.h"
+
+
+using namespace std;
+
+typedef vector<pair<unsigned long long, int>> Factorization;
+
+
+UnitTest (DivisorsIsPrime) {
+	assertFalse (isPrime(0));
+	assertFalse (isPrime(1));
+	assertTrue (isPrime(2));
+	assertTrue (isPrime(65537));
+	assertFalse (isPrime(3215031751ULL));            // strong pseudoprime to bases 2, 3, 5, 7
+	assertTrue (isPrime(2147483647ULL));
+	assertTrue (isPrime(4611686018427387847ULL));
+	assertFalse (isPrime(4611686018427387847ULL * 3));
+	assertTrue (isPrime(18446744073709551557ULL));   // largest 64-bit prime
+}
+
+UnitTest (DivisorsFactorSmall) {
+	assertTrue (factorInteger(1).empty());
+	assertThat (factorInteger(720720),
+		is(Factorization{{2, 4}, {3, 2}, {5, 1}, {7, 1}, {11, 1}, {13, 1}}));
+	assertThat (factorInteger(2147483647), is(Factorization{{2147483647ULL, 1}}));
+}
+
+UnitTest (DivisorsFactorPollard) {
+	// Products of primes above the trial division table
+	unsigned long long p = 1000003, q = 4294967291ULL;
+	assertThat (factorInteger(p * q), is(Factorization{{p, 1}, {q, 1}}));
+	assertThat (factorInteger(p * p * 12), is(Factorization{{2, 2}, {3, 1}, {p, 2}}));
+	unsigned long long r = 3037000493ULL;
+	assertThat (factorInteger(r * r), is(Factorization{{r, 2}}));
+}
+
+UnitTest (DivisorsEnumerate) {
+	assertThat (divisorsOf(1), is(vector<unsigned long long>{1}));
+	assertThat (divisorsOf(12), is(vector<unsigned long long>{1, 2, 3, 4, 6, 12}));
+	assertThat (divisorsOf(256), is(vector<unsigned long long>{1, 2, 4, 8, 16, 32, 64, 128, 256}));
+	assertThat (divisorsOf(720720).size(), is(240U));
+	assertThat (divisorsOf(2147483646).size(), is(192U));
+	assertTrue (divisorsOf(0).empty());
+}
+
+UnitTest (DivisorsCount) {
+	assertThat (divisorCount(1), is(1ULL));
+	assertThat (divisorCount(12), is(6ULL));
+	assertThat (divisorCount(720720), is(240ULL));
+	assertThat (divisorCount(0), is(0ULL));
+	// 2^31 (2^31 - 1), with a prime cofactor beyond trial division
+	assertThat (divisorCount(4611686016279904256ULL), is(64ULL));
+}
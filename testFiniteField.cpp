@@ -0,0 +1,122 @@
+/*
+ * testFiniteField.cpp
+ */
+
+#include "finitefield.h"
+
+#include <utility>
+#include <vector>
+
+#include "unittest.h"
+
+
+using namespace std;
+
+typedef vector<pair<ModPolynomial, int>> Factorization;
+
+const Residue p2 = 2;
+const Residue p17 = 17;
+const Residue bigPrime = 4611686018427387847ULL;
+
+// A deterministic pseudo-random monic polynomial of the given degree.
+static ModPolynomial randomMonic (int degree, Residue modulus, unsigned long long seed)
+{
+	vector<Residue> c(degree + 1);
+	for (int i = 0; i < degree; ++i)
+	{
+		seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+		c[i] = (seed >> 1) % modulus;
+	}
+	c[degree] = 1;
+	return ModPolynomial(modulus, c);
+}
+
+static ModPolynomial product (const Factorization& factors, Residue modulus)
+{
+	ModPolynomial result(modulus, vector<Residue>{1});
+	for (const pair<ModPolynomial, int>& f : factors)
+		for (int k = 0; k < f.second; ++k)
+			result = result * f.first;
+	return result;
+}
+
+
+UnitTest (PolynomialModulusArithmetic) {
+	ModPolynomial f = randomMonic(100, bigPrime, 1);
+	PolynomialModulus modulus(f);
+	ModPolynomial a = randomMonic(99, bigPrime, 2);
+	ModPolynomial b = randomMonic(60, bigPrime, 3);
+	assertThat (modulus.multiply(a, b), is((a * b) % f));
+	assertThat (modulus.reduce(a * a * b), is((a * a * b) % f));
+	assertThat (modulus.reduce(b), is(b));
+	assertThat (modulus.power(a, 1234567), is(a.powMod(1234567, f)));
+
+	ModPolynomial g(p17, {3, 0, 1});   // x^2 + 3
+	PolynomialModulus small(g);
+	assertThat (small.power(ModPolynomial(p17, {0, 1}), 2), is(ModPolynomial(p17, vector<Residue>{14})));
+}
+
+UnitTest (FrobeniusMapPowers) {
+	for (Residue p : {p2, p17, bigPrime})
+	{
+		ModPolynomial f = randomMonic(40, p, 4);
+		PolynomialModulus modulus(f);
+		FrobeniusMap frobenius(modulus);
+		ModPolynomial a = randomMonic(39, p, 5);
+		assertThat (frobenius(a), is(a.powMod(p, f)));
+		assertThat (frobenius(frobenius(a)), is(a.powMod(p, f).powMod(p, f)));
+	}
+}
+
+UnitTest (SquareFreeFactors) {
+	ModPolynomial a(p17, {1, 1});        // x + 1
+	ModPolynomial b(p17, {14, 0, 1});    // x^2 - 3
+	ModPolynomial c(p17, {3, 1, 0, 1});  // x^3 + x + 3
+	ModPolynomial f = a * b * b * c * c * c * ModPolynomial(p17, vector<Residue>{5});
+	assertThat (squareFreeFactors(f), is(Factorization{{a, 1}, {b, 2}, {c, 3}}));
+
+	// (x + 1)^17 == x^17 + 1 has a zero derivative
+	vector<Residue> coeffs(18, 0);
+	coeffs[0] = coeffs[17] = 1;
+	ModPolynomial g(p17, coeffs);
+	assertThat (squareFreeFactors(g * b), is(Factorization{{b, 1}, {a, 17}}));
+
+	assertTrue (squareFreeFactors(ModPolynomial(p17, vector<Residue>{3})).empty());
+}
+
+UnitTest (DistinctDegreeFactors) {
+	ModPolynomial a(p17, {1, 1});        // x + 1
+	ModPolynomial b(p17, {2, 1});        // x + 2
+	ModPolynomial c(p17, {14, 0, 1});    // x^2 - 3
+	ModPolynomial d(p17, {3, 1, 0, 1});  // x^3 + x + 3
+	assertThat (distinctDegreeFactors(a * b * c * d),
+	            is(Factorization{{a * b, 1}, {c, 2}, {d, 3}}));
+	assertThat (distinctDegreeFactors(d), is(Factorization{{d, 3}}));
+}
+
+UnitTest (EqualDegreeFactors) {
+	ModPolynomial a(bigPrime, {bigPrime - 3, 0, 1});   // x^2 - 3
+	ModPolynomial b(bigPrime, {bigPrime - 5, 0, 1});   // x^2 - 5
+	ModPolynomial c(bigPrime, {bigPrime - 6, 0, 1});   // x^2 - 6
+	assertThat (equalDegreeFactors(b * c * a, 2), is(vector<ModPolynomial>{c, b, a}));
+
+	ModPolynomial x1(p2, {1, 1});
+	ModPolynomial x2(p2, {1, 1, 1});       // x^2 + x + 1, the only irreducible quadratic
+	ModPolynomial x3(p2, {1, 1, 0, 1});    // x^3 + x + 1
+	ModPolynomial y3(p2, {1, 0, 1, 1});    // x^3 + x^2 + 1
+	assertThat (equalDegreeFactors(x3 * y3, 3), is(vector<ModPolynomial>{x3, y3}));
+	assertThat (factorModular(x1 * x2 * x2 * y3), is(Factorization{{x1, 1}, {x2, 2}, {y3, 1}}));
+}
+
+UnitTest (FactorModular) {
+	for (Residue p : {p17, bigPrime})
+	{
+		ModPolynomial f = randomMonic(60, p, 6);
+		ModPolynomial g = randomMonic(3, p, 7);
+		Factorization factors = factorModular(f * g * g);
+		assertThat (product(factors, p), is(f * g * g));
+		for (const pair<ModPolynomial, int>& h : factors)
+			assertThat (distinctDegreeFactors(h.first), is(Factorization{{h.first, h.first.getDegree()}}));
+	}
+	assertTrue (factorModular(ModPolynomial(p17, vector<Residue>{3})).empty());
+}
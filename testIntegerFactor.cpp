@@ -0,0 +1,105 @@
+/*
+ * testIntegerFactor.cpp
+ */
+
+#include "integerfactor.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "unittest.h"
+
+
+using namespace std;
+
+typedef vector<Polynomial> Factors;
+
+
+// factorOverIntegers promises no particular order, so the factors are
+// compared sorted by degree and then by coefficients.
+static Factors sorted (Factors factors) {
+	sort(factors.begin(), factors.end(), [](const Polynomial& f, const Polynomial& g) {
+		if (f.getDegree() != g.getDegree())
+			return f.getDegree() < g.getDegree();
+		for (int i = f.getDegree(); i >= 0; --i)
+			if (f.getCoeff(i) != g.getCoeff(i))
+				return f.getCoeff(i) < g.getCoeff(i);
+		return false;
+	});
+	return factors;
+}
+
+
+UnitTest (IntegerFactorProduct) {
+	Polynomial f ({Term(1, 2), Term(1, 0)});                 // x^2 + 1
+	Polynomial g ({Term(1, 2), Term(-2, 0)});                // x^2 - 2
+	Polynomial h ({Term(1, 3), Term(1, 1), Term(1, 0)});     // x^3 + x + 1
+	Polynomial k ({Term(2, 2), Term(3, 1), Term(5, 0)});     // 2x^2 + 3x + 5
+	Polynomial l (-7, 3);                                    // 3x - 7
+	// their product, expanded
+	int coeffs[] = {70, 82, 57, 109, -24, 3, -23, -29, -6, -5, 6};
+	Polynomial p (11, coeffs);
+	Factors factors;
+	Polynomial rest;
+	factorOverIntegers(p, factors, rest);
+	assertThat (sorted(factors), is(Factors{l, g, f, k, h}));
+	assertThat (rest, is(Polynomial(1)));
+}
+
+UnitTest (IntegerFactorRepeated) {
+	Polynomial f ({Term(1, 2), Term(1, 1), Term(1, 0)});     // x^2 + x + 1
+	Polynomial g ({Term(1, 2), Term(-3, 0)});                // x^2 - 3
+	// -6 f^2 g, expanded
+	int coeffs[] = {18, 36, 48, 24, 0, -12, -6};
+	Polynomial p (7, coeffs);
+	Factors factors;
+	Polynomial rest;
+	factorOverIntegers(p, factors, rest);
+	assertThat (sorted(factors), is(Factors{g, f, f}));
+	assertThat (rest, is(Polynomial(1)));
+}
+
+UnitTest (IntegerFactorIrreducible) {
+	Factors factors;
+	Polynomial rest;
+
+	// x^4 + 1 splits into factors of degree at most 2 modulo every prime.
+	Polynomial p ({Term(1, 4), Term(1, 0)});
+	factorOverIntegers(p, factors, rest);
+	assertThat (factors, is(Factors{p}));
+	assertThat (rest, is(Polynomial(1)));
+
+	// So does the minimal polynomial of sqrt(2) + sqrt(3) + sqrt(5), into
+	// at least four factors.
+	Polynomial q ({Term(1, 8), Term(-40, 6), Term(352, 4), Term(-960, 2), Term(576, 0)});
+	factorOverIntegers(q, factors, rest);
+	assertThat (factors, is(Factors{q}));
+	assertThat (rest, is(Polynomial(1)));
+
+	factorOverIntegers(Polynomial(7), factors, rest);
+	assertTrue (factors.empty());
+}
+
+UnitTest (IntegerFactorSwinnertonDyer) {
+	Factors factors;
+	Polynomial rest;
+
+	// The minimal polynomial of sqrt(2) + sqrt(3) + sqrt(5) + sqrt(7)
+	// splits into at least eight factors modulo every prime.
+	int coeffs[] = {46225, 0, -5596840, 0, 13950764, 0, -7453176, 0, 1513334,
+	                0, -141912, 0, 6476, 0, -136, 0, 1};
+	Polynomial p (17, coeffs);
+	factorOverIntegers(p, factors, rest);
+	assertThat (factors, is(Factors{p}));
+	assertThat (rest, is(Polynomial(1)));
+
+	// Those of sqrt(2) + sqrt(3) + sqrt(5) and sqrt(2) + sqrt(3) + sqrt(7),
+	// multiplied together
+	Polynomial f ({Term(1, 8), Term(-40, 6), Term(352, 4), Term(-960, 2), Term(576, 0)});
+	Polynomial g ({Term(1, 8), Term(-48, 6), Term(536, 4), Term(-1728, 2), Term(400, 0)});
+	int product[] = {230400, 0, -1379328, 0, 2108416, 0, -1166464, 0, 304848,
+	                 0, -41024, 0, 2808, 0, -88, 0, 1};
+	factorOverIntegers(Polynomial(17, product), factors, rest);
+	assertThat (sorted(factors), is(Factors{g, f}));
+	assertThat (rest, is(Polynomial(1)));
+}
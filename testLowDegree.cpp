@@ -0,0 +1,73 @@
+/*
+ * testLowDegree.cpp
+ */
+
+#include "lowdegree.h"
+
+#include <vector>
+
+#include "unittest.h"
+
+
+using namespace std;
+
+typedef vector<Polynomial> Factors;
+
+
+UnitTest (LowDegreeQuadratic) {
+	Factors factors;
+	// 6x^2 - x - 2 == (2x + 1)(3x - 2)
+	assertTrue (factorLowDegree(Polynomial({Term(6, 2), Term(-1, 1), Term(-2, 0)}), factors));
+	assertThat (factors, is(Factors{Polynomial(-2, 3), Polynomial(1, 2)}));
+
+	// -4x^2 + 4x - 1 == -(2x - 1)^2
+	factors.clear();
+	assertTrue (factorLowDegree(Polynomial({Term(-4, 2), Term(4, 1), Term(-1, 0)}), factors));
+	assertThat (factors, is(Factors{Polynomial(-1, 2), Polynomial(-1, 2)}));
+
+	// x^2 + x + 1 has discriminant -3, and 2x^2 - 3 a square-free 24
+	Polynomial f ({Term(1, 2), Term(1, 1), Term(1, 0)});
+	Polynomial g ({Term(2, 2), Term(-3, 0)});
+	factors.clear();
+	assertTrue (factorLowDegree(f, factors));
+	assertTrue (factorLowDegree(g * -1, factors));
+	assertThat (factors, is(Factors{f, g}));
+
+	// The discriminant of this one overflows 64 bits.
+	factors.clear();
+	Polynomial h ({Term(2147483647, 2), Term(-2147483647, 1), Term(-2147483647, 0)});
+	assertTrue (factorLowDegree(h, factors));
+	assertThat (factors, is(Factors{h}));
+}
+
+UnitTest (LowDegreeCubic) {
+	Factors factors;
+	Polynomial f ({Term(-2, 3), Term(1, 1), Term(5, 0)});
+	assertTrue (factorLowDegree(f, factors));
+	assertThat (factors, is(Factors{f * -1}));
+}
+
+UnitTest (LowDegreeQuartic) {
+	Factors factors;
+	// (2x^2 + 3x + 5)(x^2 - 2), expanded
+	Polynomial p ({Term(2, 4), Term(3, 3), Term(1, 2), Term(-6, 1), Term(-10, 0)});
+	assertTrue (factorLowDegree(p, factors));
+	assertThat (factors, is(Factors{Polynomial({Term(2, 2), Term(3, 1), Term(5, 0)}),
+	                                Polynomial({Term(1, 2), Term(-2, 0)})}));
+
+	// x^4 + 1 and x^4 - 10x^2 + 1 split modulo every prime, but not over
+	// the integers; (x^2 + 1)^2 has a repeated factor.
+	Polynomial q ({Term(1, 4), Term(1, 0)});
+	Polynomial r ({Term(1, 4), Term(-10, 2), Term(1, 0)});
+	Polynomial s ({Term(1, 2), Term(1, 0)});
+	factors.clear();
+	assertTrue (factorLowDegree(q, factors));
+	assertTrue (factorLowDegree(r, factors));
+	assertTrue (factorLowDegree(Polynomial({Term(1, 4), Term(2, 2), Term(1, 0)}), factors));
+	assertThat (factors, is(Factors{q, r, s, s}));
+
+	// Too large for the resolvent
+	factors.clear();
+	assertFalse (factorLowDegree(Polynomial({Term(lowDegreeCoefficientLimit, 4), Term(1, 0)}), factors));
+	assertTrue (factors.empty());
+}
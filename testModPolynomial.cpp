@@ -0,0 +1,161 @@
+/*
+ * testModPolynomial.cpp
+ */
+
+#include "modpolynomial.h"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "unittest.h"
+
+
+using namespace std;
+
+const Residue p17 = 17;
+const Residue bigPrime = 4611686018427387847ULL;
+
+// A deterministic pseudo-random polynomial of the given degree.
+ModPolynomial scrambled (int degree, Residue modulus, unsigned long long seed)
+{
+	vector<Residue> c(degree + 1);
+	for (int i = 0; i <= degree; ++i)
+	{
+		seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+		c[i] = (seed >> 1) % modulus;
+	}
+	if (c[degree] == 0)
+		c[degree] = 1;
+	return ModPolynomial(modulus, c);
+}
+
+
+UnitTest (ModPolynomialConstructors) {
+	ModPolynomial z(p17);
+	assertTrue (z.isZero());
+	assertThat (z.getDegree(), is(0));
+
+	ModPolynomial p(p17, {3, 0, 20, 0}); // 3x^2 + 3
+	assertThat (p.getDegree(), is(2));
+	assertThat (p.getCoeff(0), is(3ULL));
+	assertThat (p.getCoeff(2), is(3ULL));
+	assertThat (p.getCoeff(3), is(0ULL));
+
+	int arr[] = {-1, 0, 37};
+	Polynomial q(3, arr);
+	ModPolynomial qm(q, p17);
+	assertThat (qm, is(ModPolynomial(p17, {16, 0, 3})));
+
+	ostringstream out;
+	out << qm;
+	assertThat (out.str(), is("3x^2 + 16 (mod 17)"));
+}
+
+UnitTest (ModPolynomialArithmetic) {
+	ModPolynomial a(p17, {1, 1});      // x + 1
+	ModPolynomial b(p17, {16, 1});     // x - 1
+	assertThat (a * b, is(ModPolynomial(p17, {16, 0, 1})));
+	assertThat (a + b, is(ModPolynomial(p17, {0, 2})));
+	assertThat (a - a, is(ModPolynomial(p17)));
+
+	ModPolynomial c = a * b * a;
+	assertThat (c / a, is(a * b));
+	assertTrue ((c % b).isZero());
+	assertThat (c % ModPolynomial(p17, {0, 1}), is(ModPolynomial(p17, vector<Residue>{16})));
+}
+
+UnitTest (ModPolynomialKaratsuba) {
+	for (int n : {ModPolynomial::karatsubaThreshold + 1, 100, 257})
+	{
+		ModPolynomial a = scrambled(n, bigPrime, 1);
+		ModPolynomial b = scrambled(n / 3, bigPrime, 2);
+		ModPolynomial ab = a * b;
+		assertThat (ab.getDegree(), is(n + n / 3));
+		for (int k = 0; k <= ab.getDegree(); k += 7)
+		{
+			Residue expected = 0;
+			for (int i = 0; i <= k; ++i)
+				expected = addMod(expected, mulMod(a.getCoeff(i), b.getCoeff(k - i), bigPrime), bigPrime);
+			assertThat (ab.getCoeff(k), is(expected));
+		}
+	}
+}
+
+UnitTest (ModPolynomialNewtonDivision) {
+	int n = 3 * ModPolynomial::newtonThreshold;
+	ModPolynomial a = scrambled(2 * n, bigPrime, 3);
+	ModPolynomial b = scrambled(n, bigPrime, 4);
+	ModPolynomial q(bigPrime), r(bigPrime);
+	a.divide(b, q, r);
+	assertThat (q.getDegree(), is(n));
+	assertTrue (r.getDegree() < n);
+	assertThat (q * b + r, is(a));
+
+	ModPolynomial r2 = (a * b + r) % b;
+	assertThat (r2, is(r));
+}
+
+UnitTest (ModPolynomialMultipointEvaluate) {
+	ModPolynomial a = scrambled(300, bigPrime, 5);
+	vector<Residue> xs;
+	for (Residue x = 0; x < 211; ++x)
+		xs.push_back(x * x * 1000003ULL + 7);
+	vector<Residue> values = a.evaluate(xs);
+	assertThat (values.size(), is(xs.size()));
+	for (size_t i = 0; i < xs.size(); ++i)
+		assertThat (values[i], is(a.evaluate(xs[i])));
+
+	assertThat (a.evaluate(vector<Residue>{42}), is(vector<Residue>{a.evaluate(42)}));
+	assertTrue (a.evaluate(vector<Residue>()).empty());
+}
+
+UnitTest (ModPolynomialGcd) {
+	ModPolynomial a = scrambled(40, bigPrime, 11);
+	ModPolynomial b = scrambled(25, bigPrime, 12);
+	ModPolynomial c = scrambled(10, bigPrime, 13);
+	ModPolynomial g = gcd(a * c, b * c);
+	assertThat (g, is(c.monic()));
+	assertThat (gcd(a, ModPolynomial(bigPrime)), is(a.monic()));
+	assertThat (gcd(ModPolynomial(p17, {3, 1}), ModPolynomial(p17, {4, 1})).getDegree(), is(0));
+
+	ModPolynomial d(p17, {5, 0, 3, 1}); // x^3 + 3x^2 + 5
+	assertThat (d.derivative(), is(ModPolynomial(p17, {0, 6, 3})));
+	assertThat (ModPolynomial(p17, vector<Residue>{7}).derivative(), is(ModPolynomial(p17)));
+}
+
+UnitTest (ModPolynomialPowMod) {
+	ModPolynomial f = scrambled(20, p17, 3);
+	ModPolynomial x(p17, {0, 1});
+	// Fermat: x^17 == x in the integers mod 17, and so modulo f
+	// x^(17^2) == (x^17)^17
+	ModPolynomial x17 = x.powMod(17, f);
+	assertThat (x.powMod(17 * 17, f), is(x17.powMod(17, f)));
+	assertThat (x.powMod(5, f), is(ModPolynomial(p17, {0, 0, 0, 0, 0, 1})));
+	assertThat (x.powMod(0, f), is(ModPolynomial(p17, vector<Residue>{1})));
+}
+
+UnitTest (ModPolynomialRoots) {
+	// (x - 2)(x - 5)(x - 11)(x^2 + 1): x^2 + 1 has no roots mod 19
+	const Residue p19 = 19;
+	ModPolynomial f = ModPolynomial(p19, {17, 1}) * ModPolynomial(p19, {14, 1})
+		* ModPolynomial(p19, {8, 1}) * ModPolynomial(p19, {1, 0, 1});
+	assertThat (f.roots(), is(vector<Residue>{2, 5, 11}));
+	assertThat ((f * f).roots(), is(vector<Residue>{2, 5, 11}));
+	assertTrue (ModPolynomial(p19, {1, 0, 1}).roots().empty());
+	assertTrue (ModPolynomial(p19, vector<Residue>{3}).roots().empty());
+
+	const Residue million = 1000003;
+	vector<Residue> expected;
+	ModPolynomial product(million, vector<Residue>{1});
+	for (Residue r = 1; r <= 30; ++r)
+	{
+		Residue root = (r * r * 7919 + r) % million;
+		expected.push_back(root);
+		product = product * ModPolynomial(million, {million - root, 1});
+	}
+	sort(expected.begin(), expected.end());
+	vector<Residue> found = product.roots();
+	assertThat (found, is(expected));
+}
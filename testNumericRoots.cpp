@@ -0,0 +1,71 @@
+/*
+ * testNumericRoots.cpp
+ */
+
+#include "numericroots.h"
+
+#include <algorithm>
+#include <complex>
+#include <vector>
+
+#include "unittest.h"
+
+
+using namespace std;
+
+typedef vector<pair<int,int>> Candidates;
+
+static bool near(const vector<complex<double>>& roots, complex<double> z) {
+	for (const complex<double>& r : roots)
+		if (abs(r - z) < 1e-9 * max(1.0, abs(z)))
+			return true;
+	return false;
+}
+
+
+UnitTest (NumericRootsApproximateReal) {
+	// (x - 5)(x + 4)(3x - 1)(5x + 4) expanded
+	int coeffs[] = {80, -136, -311, -8, 15};
+	Polynomial p (5, coeffs);
+	vector<complex<double>> roots = approximateRoots(p);
+	assertThat (roots.size(), is(4u));
+	assertTrue (near(roots, 5.0));
+	assertTrue (near(roots, -4.0));
+	assertTrue (near(roots, 1.0 / 3));
+	assertTrue (near(roots, -0.8));
+}
+
+UnitTest (NumericRootsApproximateComplex) {
+	// x^4 + 4 = (x^2 + 2x + 2)(x^2 - 2x + 2)
+	Polynomial p ({Term(1, 4), Term(4, 0)});
+	vector<complex<double>> roots = approximateRoots(p);
+	assertThat (roots.size(), is(4u));
+	assertTrue (near(roots, complex<double>(1, 1)));
+	assertTrue (near(roots, complex<double>(1, -1)));
+	assertTrue (near(roots, complex<double>(-1, 1)));
+	assertTrue (near(roots, complex<double>(-1, -1)));
+}
+
+UnitTest (NumericRootsTooLarge) {
+	assertTrue (approximateRoots(Polynomial(7)).empty());
+	Polynomial p ({Term(1, maxApproximatedDegree + 1), Term(-1, 0)});
+	assertTrue (approximateRoots(p).empty());
+}
+
+UnitTest (NumericRootsNearbyRationals) {
+	vector<complex<double>> roots {5.0000001, -0.8, complex<double>(0.5, 2.0)};
+	vector<unsigned long long> denominators {1, 3, 5, 15};
+	vector<unsigned long long> numerators {1, 2, 4, 5, 8, 10, 16, 20, 40, 80};
+	Candidates proposed = nearbyRationals(roots, denominators, numerators);
+	// 5 is proposed as 5/1 and -0.8 as -4/5, and also as -1/1, since 1 is
+	// an allowed numerator next to 0.8; the complex root proposes nothing.
+	assertTrue (find(proposed.begin(), proposed.end(), make_pair(5, -1)) != proposed.end());
+	assertTrue (find(proposed.begin(), proposed.end(), make_pair(4, 5)) != proposed.end());
+	assertTrue (find(proposed.begin(), proposed.end(), make_pair(1, 1)) != proposed.end());
+	for (const pair<int,int>& f : proposed)
+		assertTrue (f.first > 0);
+	assertTrue (is_sorted(proposed.begin(), proposed.end(),
+		[](const pair<int,int>& f, const pair<int,int>& g) {
+			return abs(f.second) < abs(g.second);
+		}));
+}
@@ -0,0 +1,67 @@
+/*
+ * testPadicRoots.cpp
+ */
+
+#include "padicroots.h"
+
+#include <utility>
+#include <vector>
+
+#include "unittest.h"
+
+
+using namespace std;
+
+typedef vector<pair<int,int>> Candidates;
+
+
+UnitTest (PadicRootsSimple) {
+	// (x + 4)(-x + 5)(-3x + 1)(5x + 4), expanded
+	int coeffs[] = {80, -136, -311, -8, 15};
+	Polynomial p (5, coeffs);
+	Candidates candidates;
+	assertTrue (padicRootCandidates(p, candidates));
+	assertThat (candidates, is(Candidates{{4, 1}, {5, -1}, {1, -3}, {4, 5}}));
+}
+
+UnitTest (PadicRootsNone) {
+	Candidates candidates;
+	// x^4 + 2x^2 + 1 == (x^2 + 1)^2 has no roots modulo primes 3 mod 4
+	Polynomial p ({Term(1, 4), Term(2, 2), Term(1, 0)});
+	assertTrue (padicRootCandidates(p, candidates));
+	assertTrue (candidates.empty());
+
+	// x^3 - 2 has no rational roots, though it has roots modulo many primes
+	Polynomial q ({Term(1, 3), Term(-2, 0)});
+	assertTrue (padicRootCandidates(q, candidates));
+	assertTrue (candidates.empty());
+
+	assertTrue (padicRootCandidates(Polynomial(7), candidates));
+	assertTrue (candidates.empty());
+	assertFalse (padicRootCandidates(Polynomial(), candidates));
+}
+
+UnitTest (PadicRootsLargeCoefficients) {
+	// (65536x - 65537)(x^2 + 1) has a single rational root, whose
+	// numerator and denominator have few divisors but are large.
+	int coeffs[] = {-65537, 65536, -65537, 65536};
+	Polynomial p (4, coeffs);
+	Candidates candidates;
+	assertTrue (padicRootCandidates(p, candidates));
+	assertThat (candidates, is(Candidates{{65537, -65536}}));
+}
+
+UnitTest (PadicRootsMultiple) {
+	// (x - 5)^2 (2x + 3) = 2x^3 - 17x^2 + 20x + 75: 5 is a double root
+	// modulo every prime, and is lifted as a root of the derivative.
+	int coeffs[] = {75, 20, -17, 2};
+	Polynomial p (4, coeffs);
+	Candidates candidates;
+	assertFalse (padicRootCandidates(p, candidates));
+	assertThat (candidates, is(Candidates{{5, -1}, {3, 2}}));
+
+	// x^2 (x - 1)
+	Polynomial q ({Term(1, 3), Term(-1, 2)});
+	assertFalse (padicRootCandidates(q, candidates));
+	assertThat (candidates, is(Candidates{{0, 1}, {1, -1}}));
+}
@@ -6,10 +6,12 @@
  */
 
 #include "polynomial.h"
+#include "modarith.h"
 
 #include <array>
 #include <string>
 #include <sstream>
+#include <vector>
 
 #include "unittest.h"
 
@@ -158,6 +160,18 @@ UnitTest (PolynomialTermConstructorUnNormal) {
 
 }
 
+UnitTest (PolynomialVectorConstructor) {
+	vector<Term> terms {Term(5, 1), Term(1, 0), Term(-5, 1), Term(2, 3)};
+	assertThat (Polynomial(terms), isEqualTo(Polynomial({Term(2, 3), Term(1, 0)})));
+
+	terms = {Term(1, 0), Term(-1, 1000000)};
+	Polynomial p(terms);
+	assertThat (p.getDegree(), is(1000000));
+	assertThat (p.getCoeff(1000000), is(-1));
+	assertThat (p.getCoeff(999999), is(0));
+	assertTrue (p.sanityCheck());
+}
+
 
 
 
@@ -512,3 +526,258 @@ UnitTest(PolynomialDivideByConstants) {
 	Polynomial q8 = p1 / p0;
 	assertThat (q8, is(four));
 }
+
+
+UnitTest(PolynomialEvaluate) {
+	Polynomial p0(3, parabola); // 3x^2 - 2x + 1
+	long long value;
+
+	assertTrue (p0.evaluate(0, value));
+	assertThat (value, is(1LL));
+	assertTrue (p0.evaluate(2, value));
+	assertThat (value, is(9LL));
+	assertTrue (p0.evaluate(-3, value));
+	assertThat (value, is(34LL));
+
+	Polynomial p1(11, degreeTen); // x^10 - x^5 + 1
+	assertTrue (p1.evaluate(2, value));
+	assertThat (value, is(993LL));
+	assertTrue (p1.evaluate(-1, value));
+	assertThat (value, is(3LL));
+
+	assertTrue (zero.evaluate(17, value));
+	assertThat (value, is(0LL));
+
+	assertFalse (bad.evaluate(1, value));
+	assertFalse (p1.evaluate(1000000, value)); // 10^60 overflows
+}
+
+UnitTest(PolynomialEvaluateAt) {
+	int arr[] = {20, -1, -12};
+	Polynomial p0(3, arr); // -12x^2 - x + 20 == (3x + 4)(-4x + 5)
+	long long value;
+
+	assertTrue (p0.evaluateAt(4, 3, value));    // root -4/3
+	assertThat (value, is(0LL));
+	assertTrue (p0.evaluateAt(5, -4, value));   // root 5/4
+	assertThat (value, is(0LL));
+	assertTrue (p0.evaluateAt(1, 1, value));    // 1^2 p(-1)
+	assertThat (value, is(9LL));
+	assertTrue (p0.evaluateAt(-1, 2, value));   // 2^2 p(1/2) == -12 - 2 + 80
+	assertThat (value, is(66LL));
+
+	int arr2[] = {-256, 0, 0, 0, 81};
+	Polynomial p1(5, arr2); // 81x^4 - 256
+	assertTrue (p1.evaluateAt(4, 3, value));
+	assertThat (value, is(0LL));
+	assertTrue (p1.evaluateAt(4, 1, value));
+	assertThat (value, is(81LL * 256 - 256));
+
+	assertFalse (p0.evaluateAt(1, 0, value));
+	assertFalse (bad.evaluateAt(1, 1, value));
+}
+
+UnitTest(PolynomialMayVanishAt) {
+	int arr[] = {20, -1, -12};
+	Polynomial p0(3, arr); // -12x^2 - x + 20 == (3x + 4)(-4x + 5)
+	assertTrue (p0.mayVanishAt(4, 3));
+	assertTrue (p0.mayVanishAt(5, -4));
+	assertFalse (p0.mayVanishAt(1, 1));
+	assertFalse (p0.mayVanishAt(-1, 2));
+
+	// Values far beyond the exact evaluator's range are still ruled out.
+	Polynomial p1({Term(1, 40), Term(-1, 0)}); // x^40 - 1
+	long long value;
+	assertFalse (p1.evaluateAt(1000, 1, value));
+	assertFalse (p1.mayVanishAt(1000, 1));
+	assertTrue (p1.mayVanishAt(-1, 1));
+	assertTrue (p1.mayVanishAt(1, 1));
+
+	// Overflowing intervals bound nothing and must not rule anything out.
+	Polynomial p2({Term(1, 400), Term(-1, 0)});
+	assertTrue (p2.mayVanishAt(1000000, 1));
+
+	assertTrue (bad.mayVanishAt(1, 1));
+}
+
+UnitTest(PolynomialEvaluateMod) {
+	const unsigned long long m = 1000000007ULL;
+	Polynomial p0(3, parabola); // 3x^2 - 2x + 1
+	assertThat (p0.evaluateMod(2, m), is(9ULL));
+	assertThat (p0.evaluateMod(-3, m), is(34ULL));
+	assertThat (p0.evaluateMod(2, 7), is(2ULL));
+
+	Polynomial p1(11, degreeTen); // x^10 - x^5 + 1
+	assertThat (p1.evaluateMod(-2, m), is(1057ULL));
+
+	// Long enough to take the Estrin path, with an odd number of coefficients
+	// at some levels of the fold.
+	const int n = 3 * Polynomial::estrinThreshold + 5;
+	int coeffs[n];
+	for (int i = 0; i < n; ++i)
+		coeffs[i] = (i % 3 == 0) ? 0 : 1000 * i - 77777;
+	Polynomial p2(n, coeffs);
+	for (long long x : {0LL, 1LL, -1LL, 12345LL, -987654321LL})
+	{
+		unsigned long long expected = 0;
+		for (int i = n - 1; i >= 0; --i)
+			expected = addMod(mulMod(expected, toResidue(x, m), m), toResidue(coeffs[i], m), m);
+		assertThat (p2.evaluateMod(x, m), is(expected));
+	}
+
+	assertThat (zero.evaluateMod(5, m), is(0ULL));
+}
+
+UnitTest(PolynomialEvaluateMany) {
+	int arr[] = {-256, 0, 0, 0, 81};
+	Polynomial p0(5, arr); // 81x^4 - 256
+	vector<long long> xs {0, 1, -1, 2, 5, -10000, 3000000000LL, 4000000};
+	vector<long long> values;
+	vector<bool> exact;
+	p0.evaluate(xs, values, exact);
+	assertThat (values.size(), is(xs.size()));
+	for (size_t i = 0; i < 6; ++i)
+	{
+		long long expected;
+		assertTrue (p0.evaluate(xs[i], expected));
+		assertTrue (bool(exact[i]));
+		assertThat (values[i], is(expected));
+	}
+	assertFalse (bool(exact[6]));   // about 6.6 * 10^39
+	assertFalse (bool(exact[7]));   // fits the CRT range, but not a long long
+
+	p0.evaluate(vector<long long>(), values, exact);
+	assertTrue (values.empty());
+}
+
+UnitTest(PolynomialEvaluateModBatch) {
+	Polynomial p1(11, degreeTen); // x^10 - x^5 + 1
+	const unsigned long long m = 67108859;
+	for (size_t n : {1, 4, 5, 8, 13, 16, 37})
+	{
+		vector<long long> xs;
+		for (size_t i = 0; i < n; ++i)
+			xs.push_back((long long)(i * i * 7919) - 1000000);
+		vector<unsigned long long> values = p1.evaluateMod(xs, m);
+		assertThat (values.size(), is(n));
+		for (size_t i = 0; i < n; ++i)
+			assertThat (values[i], is(p1.evaluateMod(xs[i], m)));
+	}
+
+	const unsigned long long bigM = 1000000007ULL << 20;
+	vector<long long> xs {3, -3};
+	vector<unsigned long long> expected {p1.evaluateMod(3, bigM), p1.evaluateMod(-3, bigM)};
+	assertThat (p1.evaluateMod(xs, bigM), is(expected));
+}
+
+UnitTest(PolynomialTabulate) {
+	int arr[] = {5, -2, 0, 1};
+	Polynomial p0(4, arr); // x^3 - 2x + 5
+	vector<long long> values;
+	assertTrue (p0.tabulate(-10, 21, values));
+	assertThat (values.size(), is(21U));
+	for (int i = 0; i < 21; ++i)
+	{
+		long long expected;
+		assertTrue (p0.evaluate(i - 10, expected));
+		assertThat (values[i], is(expected));
+	}
+
+	Polynomial p1(11, degreeTen);
+	assertTrue (p1.tabulate(-50, 100, values));
+	long long expected;
+	assertTrue (p1.evaluate(49, expected));
+	assertThat (values.back(), is(expected));
+
+	assertTrue (p0.tabulate(3, 0, values));
+	assertTrue (values.empty());
+
+	// |x^3| < 2^62 up to x = 1664510
+	int cubeArr[] = {0, 0, 0, 1};
+	Polynomial cube(4, cubeArr);
+	assertFalse (cube.tabulate(1664500, 20, values));
+	assertThat (values.size(), is(11U));
+	assertThat (values.back(), is(1664510LL * 1664510LL * 1664510LL));
+
+	Polynomial forty(1, fortyTwo);
+	assertTrue (forty.tabulate(-5, 3, values));
+	assertThat (values, is(vector<long long>{42, 42, 42}));
+
+	assertFalse (bad.tabulate(0, 1, values));
+}
+
+UnitTest(PolynomialRootBounds) {
+	int arr[] = {-6, 1, 1};
+	Polynomial p0(3, arr); // x^2 + x - 6 == (x - 2)(x + 3)
+	long double positive, negative;
+	p0.rootBounds(positive, negative);
+	assertTrue (positive >= 2 && positive < 4);
+	assertTrue (negative >= 3 && negative < 4);
+
+	int arr2[] = {2, 3, 1};
+	Polynomial p1(3, arr2); // x^2 + 3x + 2 == (x + 1)(x + 2), no positive roots
+	p1.rootBounds(positive, negative);
+	assertTrue (positive == 0);
+	assertTrue (negative >= 2);
+
+	int arr3[] = {-4, 0, -9};
+	Polynomial p2(3, arr3); // -9x^2 - 4, no real roots
+	p2.rootBounds(positive, negative);
+	assertTrue (positive == 0 && negative == 0);
+
+	int arr4[] = {-256, 0, 0, 0, 81};
+	Polynomial p3(5, arr4); // roots +-4/3
+	p3.rootBounds(positive, negative);
+	assertTrue (positive >= 4.0L / 3 && positive < 2.5);
+	assertTrue (negative >= 4.0L / 3 && negative < 2.5);
+
+	zero.rootBounds(positive, negative);
+	assertTrue (positive == 0 && negative == 0);
+}
+
+UnitTest(PolynomialSignVariations) {
+	int positive, negative;
+	Polynomial p0(3, parabola); // 3x^2 - 2x + 1
+	p0.signVariations(positive, negative);
+	assertThat (positive, is(2));
+	assertThat (negative, is(0));
+
+	Polynomial p1(11, degreeTen); // x^10 - x^5 + 1
+	p1.signVariations(positive, negative);
+	assertThat (positive, is(2));
+	assertThat (negative, is(0));   // p(-x) == x^10 + x^5 + 1
+
+	int arr[] = {-1, 0, 0, 1}; // x^3 - 1
+	Polynomial p2(4, arr);
+	p2.signVariations(positive, negative);
+	assertThat (positive, is(1));
+	assertThat (negative, is(0));
+
+	int arr2[] = {1, 0, 2, 0, 1}; // x^4 + 2x^2 + 1
+	Polynomial p3(5, arr2);
+	p3.signVariations(positive, negative);
+	assertThat (positive, is(0));
+	assertThat (negative, is(0));
+}
+
+UnitTest(PolynomialContent) {
+	int arr[] = {6, 12, 6}; // 6x^2 + 12x + 6
+	Polynomial p0(3, arr);
+	assertThat (p0.content(), is(6));
+	assertThat (p0.primitivePart(), is(Polynomial({Term(1, 2), Term(2, 1), Term(1, 0)})));
+
+	int arr2[] = {-4, 0, -9}; // -9x^2 - 4
+	Polynomial p1(3, arr2);
+	assertThat (p1.content(), is(-1));
+	assertThat (p1.primitivePart(), is(Polynomial({Term(9, 2), Term(4, 0)})));
+
+	int arr3[] = {0, -10, 0, 15}; // 15x^3 - 10x
+	Polynomial p2(4, arr3);
+	assertThat (p2.content(), is(5));
+	assertThat (p2.primitivePart(), is(Polynomial({Term(3, 3), Term(-2, 1)})));
+
+	assertThat (Polynomial(-7).content(), is(-7));
+	assertThat (Polynomial(-7).primitivePart(), is(Polynomial(1)));
+	assertThat (zero.content(), is(0));
+	assertThat (bad.content(), is(0));
+}
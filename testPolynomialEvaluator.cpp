@@ -0,0 +1,79 @@
+/*
+ * testPolynomialEvaluator.cpp
+ */
+
+#include "polynomialevaluator.h"
+
+#include <cmath>
+#include <vector>
+
+#include "unittest.h"
+
+
+using namespace std;
+
+
+// Reference value by plain Horner over getCoeff.
+double reference (const Polynomial& p, double x)
+{
+	double result = 0;
+	for (int i = p.getDegree(); i >= 0; --i)
+		result = result * x + p.getCoeff(i);
+	return result;
+}
+
+
+UnitTest (PolynomialEvaluatorFixedDegrees) {
+	for (int n = 1; n <= PolynomialEvaluator::maxFixedDegree + 1; ++n)
+	{
+		vector<int> c(n);
+		for (int i = 0; i < n; ++i)
+			c[i] = 3 * i - 7;
+		Polynomial p(n, c.data());
+		PolynomialEvaluator eval(p);
+		for (double x : {0.0, 1.0, -2.0, 0.5, 3.25})
+			assertThat (eval(x), is(reference(p, x)));
+	}
+
+	PolynomialEvaluator zeroEval(Polynomial(0));
+	assertThat (zeroEval(12.5), is(0.0));
+}
+
+UnitTest (PolynomialEvaluatorSparse) {
+	int degreeTen[] = {1, 0, 0, 0, 0, -1, 0, 0, 0, 0, 1}; // x^10 - x^5 + 1
+	Polynomial p(11, degreeTen);
+	PolynomialEvaluator eval(p);
+	for (double x : {0.0, 1.0, -1.0, 2.0, -3.0})
+		assertThat (eval(x), is(reference(p, x)));
+
+	int shifted[40] = {0};
+	shifted[3] = 2;
+	shifted[17] = -5;
+	shifted[39] = 1;   // x^39 - 5x^17 + 2x^3
+	Polynomial q(40, shifted);
+	PolynomialEvaluator evalQ(q);
+	for (double x : {0.0, 1.0, -1.0, 2.0, -0.5})
+		assertThat (evalQ(x), is(reference(q, x)));
+}
+
+UnitTest (PolynomialEvaluatorDense) {
+	for (int n : {10, 16, 17, 61})
+	{
+		vector<int> c(n);
+		for (int i = 0; i < n; ++i)
+			c[i] = (i % 5) - 2;
+		c[n - 1] = 1;
+		Polynomial p(n, c.data());
+		PolynomialEvaluator eval(p);
+		for (double x : {0.0, 1.0, -1.0, 2.0, 0.75, -1.125})
+		{
+			double expected = reference(p, x);
+			assertTrue (fabs(eval(x) - expected) <= 1e-12 * (1 + fabs(expected)));
+		}
+	}
+}
+
+UnitTest (PolynomialEvaluatorBad) {
+	PolynomialEvaluator eval((Polynomial()));
+	assertTrue (std::isnan(eval(1.0)));
+}
@@ -0,0 +1,53 @@
+/*
+ * testReciprocal.cpp
+ */
+
+#include "reciprocal.h"
+
+#include "unittest.h"
+
+
+using namespace std;
+
+
+UnitTest (ReciprocalHalve) {
+	int minusOnes, plusOnes;
+	Polynomial half;
+
+	// (x^2 + x + 1)(x^2 + 2x + 1) == x^2 r(x + 1/x), r == (y + 1)(y + 2)
+	int coeffs[] = {1, 3, 4, 3, 1};
+	assertTrue (halveReciprocal(Polynomial(5, coeffs), minusOnes, plusOnes, half));
+	assertThat (minusOnes, is(0));
+	assertThat (plusOnes, is(0));
+	assertThat (half, is(Polynomial({Term(1, 2), Term(3, 1), Term(2, 0)})));
+
+	// x^5 - 1 == (x - 1)(x^4 + x^3 + x^2 + x + 1)
+	assertTrue (halveReciprocal(Polynomial({Term(1, 5), Term(-1, 0)}), minusOnes, plusOnes, half));
+	assertThat (minusOnes, is(1));
+	assertThat (plusOnes, is(0));
+	assertThat (half, is(Polynomial({Term(1, 2), Term(1, 1), Term(-1, 0)})));
+
+	// x^4 - 1 == (x - 1)(x + 1)(x^2 + 1)
+	assertTrue (halveReciprocal(Polynomial({Term(1, 4), Term(-1, 0)}), minusOnes, plusOnes, half));
+	assertThat (minusOnes, is(1));
+	assertThat (plusOnes, is(1));
+	assertThat (half, is(Polynomial(0, 1)));
+
+	assertFalse (halveReciprocal(Polynomial({Term(1, 4), Term(2, 1), Term(1, 0)}), minusOnes, plusOnes, half));
+	assertFalse (halveReciprocal(Polynomial({Term(2, 4), Term(1, 0)}), minusOnes, plusOnes, half));
+}
+
+UnitTest (ReciprocalLift) {
+	int coeffs[] = {1, 1, 1, 1, 1};
+	assertThat (liftReciprocal(Polynomial({Term(1, 2), Term(1, 1), Term(-1, 0)})), is(Polynomial(5, coeffs)));
+	assertThat (liftReciprocal(Polynomial(2, 1)), is(Polynomial({Term(1, 2), Term(2, 1), Term(1, 0)})));
+
+	// Lifting undoes halving.
+	int longer[] = {3, -1, 4, 1, -5, 9, -5, 1, 4, -1, 3};
+	Polynomial p (11, longer);
+	int minusOnes, plusOnes;
+	Polynomial half;
+	assertTrue (halveReciprocal(p, minusOnes, plusOnes, half));
+	assertThat (half.getDegree(), is(5));
+	assertThat (liftReciprocal(half), is(p));
+}
@@ -0,0 +1,78 @@
+/*
+ * testRootSieve.cpp
+ */
+
+#include "rootsieve.h"
+
+#include <utility>
+#include <vector>
+
+#include "divisors.h"
+#include "unittest.h"
+
+
+using namespace std;
+
+typedef vector<pair<int,int>> Candidates;
+
+
+UnitTest (RootSieveDefaultPrimes) {
+	vector<unsigned long long> primes = RootSieve::defaultPrimes(3);
+	assertThat (primes.size(), is(3u));
+	assertThat (primes[0], is(67108859ULL));
+	assertTrue (primes[1] < primes[0]);
+	assertTrue (primes[2] < primes[1]);
+	assertTrue (isPrime(primes[1]));
+	assertTrue (isPrime(primes[2]));
+	assertTrue (RootSieve::defaultPrimes(0).empty());
+}
+
+UnitTest (RootSieveKeepsRoots) {
+	// (3x + 4)(-3x + 4)(9x^2 + 16) = -81x^4 + 256
+	Polynomial p ({Term(-81, 4), Term(256, 0)});
+	RootSieve sieve (RootSieve::defaultPrimes(RootSieve::defaultPrimeCount));
+	sieve.setPolynomial(p);
+	Candidates candidates {{1, 1}, {4, 3}, {2, 3}, {4, -3}, {-4, 3}, {16, 9}, {256, 1}};
+	vector<bool> passed = sieve.screen(candidates);
+	assertThat (passed.size(), is(candidates.size()));
+	assertFalse (bool(passed[0]));
+	assertTrue (bool(passed[1]));
+	assertFalse (bool(passed[2]));
+	assertTrue (bool(passed[3]));
+	assertTrue (bool(passed[4]));
+	assertFalse (bool(passed[5]));
+	assertFalse (bool(passed[6]));
+	assertThat (sieve.getTested(), is(7LL));
+	assertThat (sieve.getRejected(), is(4LL));
+}
+
+UnitTest (RootSieveUnscreenable) {
+	// a is a multiple of the only sieving prime, so -b/a has no residue
+	// and the candidate must be passed on for exact testing.
+	Polynomial p ({Term(1, 2), Term(1, 0)});
+	RootSieve sieve (vector<unsigned long long>{7});
+	sieve.setPolynomial(p);
+	vector<bool> passed = sieve.screen(Candidates{{1, 7}, {1, 2}});
+	assertTrue (bool(passed[0]));
+	assertFalse (bool(passed[1]));
+}
+
+UnitTest (RootSieveNoPrimes) {
+	Polynomial p ({Term(1, 2), Term(1, 0)});
+	RootSieve sieve (vector<unsigned long long>{});
+	sieve.setPolynomial(p);
+	vector<bool> passed = sieve.screen(Candidates{{1, 1}, {2, 1}});
+	assertTrue (bool(passed[0]));
+	assertTrue (bool(passed[1]));
+	assertThat (sieve.getRejected(), is(0LL));
+}
+
+UnitTest (RootSieveCountsAccumulate) {
+	RootSieve sieve (RootSieve::defaultPrimes(1));
+	sieve.setPolynomial(Polynomial ({Term(1, 2), Term(-4, 0)}));
+	sieve.screen(Candidates{{2, 1}, {3, 1}});
+	sieve.setPolynomial(Polynomial ({Term(1, 1), Term(-3, 0)}));
+	sieve.screen(Candidates{{-3, 1}, {3, 1}});
+	assertThat (sieve.getTested(), is(4LL));
+	assertThat (sieve.getRejected(), is(2LL));
+}